@@ -0,0 +1,89 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "batch.h"
+
+#define BATCH_LINE_SIZE 256
+
+struct batch
+{
+    FILE *in;
+    FILE *out;
+    batch_Job job;
+    pthread_mutex_t inputLock;
+    pthread_mutex_t outputLock;
+    pthread_cond_t turn;
+    size_t nextInput;
+    size_t nextOutput;
+};
+
+static void *xrealloc(void *m, size_t size)
+{
+    void *m2 = realloc(m, size);
+    if (!m2) exit(1);
+    return m2;
+}
+
+static char *readLine(FILE *in)
+{
+    size_t size = BATCH_LINE_SIZE;
+    size_t len = 0;
+    char *line = xrealloc(0, size);
+    while (fgets(line + len, size - len, in))
+    {
+        len += strlen(line + len);
+        if (len && line[len - 1] == '\n')
+        {
+            line[len - 1] = 0;
+            return line;
+        }
+        if (len + 1 == size) line = xrealloc(line, size *= 2);
+    }
+    if (len) return line;
+    free(line);
+    return 0;
+}
+
+static void *work(void *arg)
+{
+    struct batch *self = arg;
+    for (;;)
+    {
+        pthread_mutex_lock(&self->inputLock);
+        char *line = readLine(self->in);
+        size_t seq = self->nextInput++;
+        pthread_mutex_unlock(&self->inputLock);
+        if (!line) return 0;
+
+        char *result = self->job(line);
+        free(line);
+
+        pthread_mutex_lock(&self->outputLock);
+        while (self->nextOutput != seq)
+        {
+            pthread_cond_wait(&self->turn, &self->outputLock);
+        }
+        fputs(result, self->out);
+        fputc('\n', self->out);
+        fflush(self->out);
+        ++self->nextOutput;
+        pthread_cond_broadcast(&self->turn);
+        pthread_mutex_unlock(&self->outputLock);
+        free(result);
+    }
+}
+
+void batch_run(FILE *in, FILE *out, unsigned int workers, batch_Job job)
+{
+    struct batch self = { in, out, job, PTHREAD_MUTEX_INITIALIZER,
+        PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, 0 };
+    if (!workers) workers = 1;
+    pthread_t *threads = xrealloc(0, workers * sizeof *threads);
+    unsigned int started = 0;
+    while (started < workers - 1
+            && !pthread_create(&threads[started], 0, work, &self)) ++started;
+    work(&self);
+    for (unsigned int i = 0; i < started; ++i) pthread_join(threads[i], 0);
+    free(threads);
+}
@@ -0,0 +1,10 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdio.h>
+
+typedef char *(*batch_Job)(const char *line);
+
+void batch_run(FILE *in, FILE *out, unsigned int workers, batch_Job job);
+
+#endif
@@ -0,0 +1,6 @@
+batch_MODULES:= batch
+batch_V_MAJ:= 0
+batch_V_MIN:= 0
+batch_V_REV:= 1
+batch_LIBS:= pthread
+$(call librules,batch)
@@ -1,29 +1,67 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include "../batch/batch.h"
 #include "../hugeint/hugeint.h"
 
+static char *divideJob(const char *line)
+{
+    const char *divisorStr = line + strspn(line, " \t");
+    divisorStr += strspn(divisorStr, "0123456789");
+    hugeint *dividend = hugeint_parse(line);
+    hugeint *divisor = hugeint_parse(divisorStr);
+    hugeint *remain;
+    hugeint *result = hugeint_div(dividend, divisor, &remain);
+    hugeint_free(divisor);
+    hugeint_free(dividend);
+    if (!result)
+    {
+        char *error = malloc(sizeof "error");
+        if (!error) exit(1);
+        strcpy(error, "error");
+        return error;
+    }
+    char *output = malloc(hugeint_decimalDigitsUpperBound(result)
+            + hugeint_decimalDigitsUpperBound(remain) + 2);
+    if (!output) exit(1);
+    size_t resultlen = hugeint_toStringInto(result, output);
+    output[resultlen] = ' ';
+    hugeint_toStringInto(remain, output + resultlen + 1);
+    hugeint_free(result);
+    hugeint_free(remain);
+    return output;
+}
+
 int main(int argc, char **argv)
 {
-    if (argc != 3)
+    int batch = argc >= 2 && !strcmp(argv[1], "-b");
+    int workers = batch && argc == 4 && !strcmp(argv[2], "-j");
+    if (batch ? argc != 2 && !workers : argc != 3)
     {
-        fprintf(stderr, "Usage: %s [dividend] [divisor]\n", argv[0]);
+        fprintf(stderr, "Usage: %s [dividend] [divisor]\n"
+                "       %s -b [-j workers]\n", argv[0], argv[0]);
         return 1;
     }
+    if (batch)
+    {
+        batch_run(stdin, stdout, workers ? atoi(argv[3]) : 1, divideJob);
+        return 0;
+    }
     hugeint *dividend = hugeint_parse(argv[1]);
     hugeint *divisor = hugeint_parse(argv[2]);
     hugeint *remain;
     hugeint *result = hugeint_div(dividend, divisor, &remain);
-    free(divisor);
-    free(dividend);
+    hugeint_free(divisor);
+    hugeint_free(dividend);
     if (!result)
     {
         fputs("Error: division unsuccessful.\n", stderr);
         return 1;
     }
     char *resultstr = hugeint_toString(result);
-    free(result);
+    hugeint_free(result);
     char *remainstr = hugeint_toString(remain);
-    free(remain);
+    hugeint_free(remain);
     puts(resultstr);
     free(resultstr);
     fputs("remainder: ", stdout);
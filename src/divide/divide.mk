@@ -1,5 +1,6 @@
 divide_MODULES:= divide
-divide_STATICDEPS:= hugeint
-divide_STATICLIBS:= hugeint
+divide_STATICDEPS:= hugeint batch
+divide_STATICLIBS:= hugeint batch
+divide_LIBS:= pthread m
 $(call binrules,divide)
 
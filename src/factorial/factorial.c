@@ -1,8 +1,30 @@
 #include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include "../batch/batch.h"
 #include "../hugeint/hugeint.h"
 
+#define LEAF_FACTORS 8
+#define STORAGE_THRESHOLD ((size_t)64 << 20)
+#define PROGRESS_GRANULARITY ((size_t)1 << 24)
+#define PROGRESS_WIDTH 50
+#define CONVERT_UNITS 12
+
+static const char progressBar[PROGRESS_WIDTH + 1] =
+    "##################################################";
+
+static int showProgress(void *ctx, size_t done, size_t remaining)
+{
+    const char *label = ctx;
+    double total = (double)done + remaining;
+    unsigned int percent = total > 0 ? (unsigned int)(100 * done / total)
+            : 100;
+    fprintf(stderr, "\r%-11s [%-*.*s] %3u%%", label, PROGRESS_WIDTH,
+            percent * PROGRESS_WIDTH / 100, progressBar, percent);
+    return 0;
+}
+
 static hugeint_Uint floorLog2(hugeint_Uint n)
 {
     hugeint_Uint bitIndex = sizeof(hugeint_Uint) * CHAR_BIT - 1;
@@ -10,28 +32,48 @@ static hugeint_Uint floorLog2(hugeint_Uint n)
     return bitIndex;
 }
 
-static hugeint *recursiveProduct(int n, hugeint **cn)
+static size_t stepUnits(hugeint_Uint h)
 {
-    int m = n/2;
-    if (!m)
+    return (size_t)h * (floorLog2(h) + 1);
+}
+
+static size_t progressUnits(hugeint_Uint n)
+{
+    if (n < 2) return 1;
+    size_t units = 0;
+    hugeint_Uint h = 0;
+    hugeint_Uint high = 1;
+    hugeint_Uint log2n = floorLog2(n);
+
+    while (h != n)
     {
-        hugeint_addUintToSelf(cn, 2);
-        return hugeint_clone(*cn);
+        h = n >> log2n--;
+        hugeint_Uint len = high;
+        high = (h - 1) | 1;
+        if (high > len) units += stepUnits(h);
     }
-    if (n == 2)
+    return units + CONVERT_UNITS * stepUnits(n);
+}
+
+static hugeint *recursiveProduct(hugeint_Uint n, hugeint_Uint *cn)
+{
+    if (n <= LEAF_FACTORS)
     {
-        hugeint_addUintToSelf(cn, 2);
-        hugeint *f1 = hugeint_clone(*cn);
-        hugeint_addUintToSelf(cn, 2);
-        hugeint *result = hugeint_mult(*cn, f1);
-        free(f1);
+        *cn += 2;
+        hugeint *result = hugeint_fromUint(*cn);
+        while (--n)
+        {
+            *cn += 2;
+            hugeint_multUintToSelf(&result, *cn);
+        }
         return result;
     }
+    hugeint_Uint m = n/2;
     hugeint *factor1 = recursiveProduct(n - m, cn);
     hugeint *factor2 = recursiveProduct(m, cn);
     hugeint *result = hugeint_mult(factor1, factor2);
-    free(factor1);
-    free(factor2);
+    hugeint_free(factor1);
+    hugeint_free(factor2);
     return result;
 }
 
@@ -40,7 +82,7 @@ hugeint *factorial(hugeint_Uint n)
     if (n < 2) return hugeint_fromUint(1);
     hugeint *p = hugeint_fromUint(1);
     hugeint *r = hugeint_fromUint(1);
-    hugeint *cn = hugeint_fromUint(1);
+    hugeint_Uint cn = 1;
     hugeint_Uint h = 0;
     hugeint_Uint shift = 0;
     hugeint_Uint high = 1;
@@ -56,34 +98,86 @@ hugeint *factorial(hugeint_Uint n)
 
         if (len > 0)
         {
+            hugeint_progressStep(stepUnits(h));
             hugeint *prod = recursiveProduct(len, &cn);
             hugeint *tmp = hugeint_mult(p, prod);
-            free(prod);
-            free(p);
+            hugeint_free(prod);
+            hugeint_free(p);
             p = tmp;
             tmp = hugeint_mult(r, p);
-            free(r);
+            hugeint_free(r);
             r = tmp;
         }
     }
 
-    free(cn);
-    free(p);
+    hugeint_free(p);
     hugeint_shiftLeft(&r, shift);
     return r;
 }
 
+static char *factorialJob(const char *line)
+{
+    hugeint *result = factorial(strtoull(line, 0, 10));
+    char *factstr = hugeint_toString(result);
+    hugeint_free(result);
+    return factstr;
+}
+
 int main(int argc, char **argv)
 {
-    if (argc != 2)
+    int verbose = 0;
+    int batch = 0;
+    unsigned int workers = 0;
+    const char *storage = 0;
+    int arg = 1;
+    for (; arg < argc; ++arg)
+    {
+        if (!strcmp(argv[arg], "-v")) verbose = 1;
+        else if (!strcmp(argv[arg], "-b")) batch = 1;
+        else if (!strcmp(argv[arg], "-j") && arg < argc - 1)
+        {
+            workers = atoi(argv[++arg]);
+        }
+        else if (!strcmp(argv[arg], "-s") && arg < argc - 1)
+        {
+            storage = argv[++arg];
+        }
+        else break;
+    }
+    if (batch ? arg != argc || verbose : arg != argc - 1 || workers)
     {
-        fprintf(stderr, "Usage: %s [number]\n", argv[0]);
+        fprintf(stderr, "Usage: %s [-v] [-s directory] [number]\n"
+                "       %s -b [-j workers] [-s directory]\n",
+                argv[0], argv[0]);
         return 1;
     }
-    hugeint_Uint number = atoi(argv[1]);
+    if (storage) hugeint_setStorage(storage, STORAGE_THRESHOLD);
+    if (batch)
+    {
+        batch_run(stdin, stdout, workers, factorialJob);
+        return 0;
+    }
+    hugeint_Uint number = atoi(argv[argc - 1]);
+    if (verbose)
+    {
+        hugeint_setProgressCallback(showProgress, "multiplying",
+                PROGRESS_GRANULARITY);
+        hugeint_progressBegin(progressUnits(number));
+    }
     hugeint *result = factorial(number);
+    if (verbose)
+    {
+        hugeint_setProgressCallback(showProgress, "converting",
+                PROGRESS_GRANULARITY);
+        hugeint_progressStep(CONVERT_UNITS * stepUnits(number));
+    }
     char *factstr = hugeint_toString(result);
-    free(result);
+    if (verbose)
+    {
+        hugeint_progressEnd();
+        fputc('\n', stderr);
+    }
+    hugeint_free(result);
     puts(factstr);
     free(factstr);
     return 0;
@@ -1,5 +1,6 @@
 factorial_MODULES:= factorial
-factorial_STATICDEPS:= hugeint
-factorial_STATICLIBS:= hugeint
+factorial_STATICDEPS:= hugeint batch
+factorial_STATICLIBS:= hugeint batch
+factorial_LIBS:= pthread m
 $(call binrules,factorial)
 
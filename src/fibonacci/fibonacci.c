@@ -0,0 +1,21 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../hugeint/hugeint.h"
+
+int main(int argc, char **argv)
+{
+    int lucas = argc == 3 && !strcmp(argv[1], "-l");
+    if (argc != 2 && !lucas)
+    {
+        fprintf(stderr, "Usage: %s [-l] [number]\n", argv[0]);
+        return 1;
+    }
+    hugeint_Uint number = strtoull(argv[argc - 1], 0, 10);
+    hugeint *result = lucas ? hugeint_lucas(number) : hugeint_fib(number);
+    char *fibstr = hugeint_toString(result);
+    hugeint_free(result);
+    puts(fibstr);
+    free(fibstr);
+    return 0;
+}
@@ -0,0 +1,5 @@
+fibonacci_MODULES:= fibonacci
+fibonacci_STATICDEPS:= hugeint
+fibonacci_STATICLIBS:= hugeint
+fibonacci_LIBS:= pthread m
+$(call binrules,fibonacci)
@@ -0,0 +1,134 @@
+#include <stdint.h>
+
+#include "internal.h"
+
+static unsigned int popcountLimb(hugeint_Uint v)
+{
+    const hugeint_Uint m1 = ~(hugeint_Uint)0U / 3;
+    const hugeint_Uint m2 = ~(hugeint_Uint)0U / 15 * 3;
+    const hugeint_Uint m4 = ~(hugeint_Uint)0U / 255 * 15;
+    const hugeint_Uint h = ~(hugeint_Uint)0U / 255;
+    v -= (v >> 1) & m1;
+    v = (v & m2) + ((v >> 2) & m2);
+    v = (v + (v >> 4)) & m4;
+    return (unsigned int)((v * h) >> (HUGEINT_ELEMENT_BITS - CHAR_BIT));
+}
+
+hugeint *hugeint_and(const hugeint *a, const hugeint *b)
+{
+    if (a->n > b->n)
+    {
+        const hugeint *tmp = a;
+        a = b;
+        b = tmp;
+    }
+    hugeint *result = hugeint_createSized(a->n);
+    for (size_t i = 0; i < a->n; ++i) result->e[i] = a->e[i] & b->e[i];
+    hugeint_autoscale(&result);
+    return result;
+}
+
+hugeint *hugeint_or(const hugeint *a, const hugeint *b)
+{
+    if (a->n < b->n)
+    {
+        const hugeint *tmp = a;
+        a = b;
+        b = tmp;
+    }
+    hugeint *result = hugeint_createSized(a->n);
+    for (size_t i = 0; i < b->n; ++i) result->e[i] = a->e[i] | b->e[i];
+    for (size_t i = b->n; i < a->n; ++i) result->e[i] = a->e[i];
+    return result;
+}
+
+hugeint *hugeint_xor(const hugeint *a, const hugeint *b)
+{
+    if (a->n < b->n)
+    {
+        const hugeint *tmp = a;
+        a = b;
+        b = tmp;
+    }
+    hugeint *result = hugeint_createSized(a->n);
+    for (size_t i = 0; i < b->n; ++i) result->e[i] = a->e[i] ^ b->e[i];
+    for (size_t i = b->n; i < a->n; ++i) result->e[i] = a->e[i];
+    hugeint_autoscale(&result);
+    return result;
+}
+
+hugeint *hugeint_andnot(const hugeint *a, const hugeint *b)
+{
+    size_t n = a->n < b->n ? a->n : b->n;
+    hugeint *result = hugeint_createSized(a->n);
+    for (size_t i = 0; i < n; ++i) result->e[i] = a->e[i] & ~b->e[i];
+    for (size_t i = n; i < a->n; ++i) result->e[i] = a->e[i];
+    hugeint_autoscale(&result);
+    return result;
+}
+
+void hugeint_andToSelf(hugeint **self, const hugeint *other)
+{
+    hugeint_Uint *e = (*self)->e;
+    size_t n = (*self)->n < other->n ? (*self)->n : other->n;
+    for (size_t i = 0; i < n; ++i) e[i] &= other->e[i];
+    for (size_t i = n; i < (*self)->n; ++i) e[i] = 0;
+    hugeint_autoscale(self);
+}
+
+void hugeint_orToSelf(hugeint **self, const hugeint *other)
+{
+    if ((*self)->n < other->n) *self = hugeint_scale(*self, other->n);
+    hugeint_Uint *e = (*self)->e;
+    for (size_t i = 0; i < other->n; ++i) e[i] |= other->e[i];
+}
+
+void hugeint_xorToSelf(hugeint **self, const hugeint *other)
+{
+    if ((*self)->n < other->n) *self = hugeint_scale(*self, other->n);
+    hugeint_Uint *e = (*self)->e;
+    for (size_t i = 0; i < other->n; ++i) e[i] ^= other->e[i];
+    hugeint_autoscale(self);
+}
+
+void hugeint_andnotToSelf(hugeint **self, const hugeint *other)
+{
+    hugeint_Uint *e = (*self)->e;
+    size_t n = (*self)->n < other->n ? (*self)->n : other->n;
+    for (size_t i = 0; i < n; ++i) e[i] &= ~other->e[i];
+    hugeint_autoscale(self);
+}
+
+int hugeint_testBit(const hugeint *self, size_t bit)
+{
+    size_t limb = bit / HUGEINT_ELEMENT_BITS;
+    if (limb >= self->n) return 0;
+    return (int)(self->e[limb] >> (bit % HUGEINT_ELEMENT_BITS) & 1U);
+}
+
+void hugeint_setBit(hugeint **self, size_t bit)
+{
+    size_t limb = bit / HUGEINT_ELEMENT_BITS;
+    if (limb >= (*self)->n) *self = hugeint_scale(*self, limb + 1);
+    (*self)->e[limb] |= (hugeint_Uint)1U << (bit % HUGEINT_ELEMENT_BITS);
+}
+
+size_t hugeint_popcount(const hugeint *self)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < self->n; ++i) count += popcountLimb(self->e[i]);
+    return count;
+}
+
+size_t hugeint_bitLength(const hugeint *self)
+{
+    return self->n * HUGEINT_ELEMENT_BITS - leadingZeros(self->e[self->n - 1]);
+}
+
+size_t hugeint_scanLowestSet(const hugeint *self)
+{
+    if (hugeint_isZero(self)) return SIZE_MAX;
+    size_t i = 0;
+    while (!self->e[i]) ++i;
+    return i * HUGEINT_ELEMENT_BITS + trailingZeros(self->e[i]);
+}
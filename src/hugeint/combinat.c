@@ -0,0 +1,124 @@
+#include <string.h>
+
+#include "internal.h"
+
+#define HUGEINT_BINOMIAL_SIEVE_RATIO 16
+
+struct factors
+{
+    size_t size;
+    size_t count;
+    hugeint **values;
+    hugeint_Uint limb;
+};
+
+static void factorsInit(struct factors *self)
+{
+    self->size = 64;
+    self->count = 0;
+    self->values = xmalloc(self->size * sizeof *self->values);
+    self->limb = 1;
+}
+
+static void factorsFlush(struct factors *self)
+{
+    if (self->count == self->size)
+    {
+        self->size *= 2;
+        self->values = xrealloc(self->values,
+                self->size * sizeof *self->values);
+    }
+    self->values[self->count++] = hugeint_fromUint(self->limb);
+}
+
+static void factorsAdd(struct factors *self, hugeint_Uint factor)
+{
+    hugeint_Uint hi;
+    hugeint_Uint lo = mulLimb(self->limb, factor, &hi);
+    if (hi)
+    {
+        factorsFlush(self);
+        lo = factor;
+    }
+    self->limb = lo;
+}
+
+static hugeint *factorsProduct(struct factors *self)
+{
+    factorsFlush(self);
+    hugeint *result = hugeint_productArray(self->count, self->values);
+    for (size_t i = 0; i < self->count; ++i) hugeint_free(self->values[i]);
+    free(self->values);
+    return result;
+}
+
+static char *sieve(hugeint_Uint n)
+{
+    if (n >= SIZE_MAX) exit(1);
+    char *composite = xmalloc(n + 1);
+    memset(composite, 0, n + 1);
+    for (hugeint_Uint p = 2; p <= n / p; ++p)
+    {
+        if (composite[p]) continue;
+        for (hugeint_Uint m = p * p; m <= n; m += p) composite[m] = 1;
+    }
+    return composite;
+}
+
+static hugeint *fallingBinomial(hugeint_Uint n, hugeint_Uint k)
+{
+    struct factors factors;
+    factorsInit(&factors);
+    for (hugeint_Uint i = 0; i < k; ++i) factorsAdd(&factors, n - i);
+    hugeint *numerator = factorsProduct(&factors);
+    factorsInit(&factors);
+    for (hugeint_Uint i = 2; i <= k; ++i) factorsAdd(&factors, i);
+    hugeint *denominator = factorsProduct(&factors);
+    hugeint *result = hugeint_divExact(numerator, denominator);
+    hugeint_free(denominator);
+    hugeint_free(numerator);
+    return result;
+}
+
+hugeint *hugeint_binomial(hugeint_Uint n, hugeint_Uint k)
+{
+    if (k > n) return hugeint_create();
+    if (k > n - k) k = n - k;
+    if (!k) return hugeint_fromUint(1);
+    if (k < n / HUGEINT_BINOMIAL_SIEVE_RATIO) return fallingBinomial(n, k);
+
+    char *composite = sieve(n);
+    struct factors factors;
+    factorsInit(&factors);
+    for (hugeint_Uint p = 2; p <= n; ++p)
+    {
+        if (composite[p]) continue;
+        hugeint_Uint a = n;
+        hugeint_Uint b = k;
+        hugeint_Uint c = n - k;
+        while (a)
+        {
+            a /= p;
+            b /= p;
+            c /= p;
+            for (hugeint_Uint e = a - b - c; e; --e) factorsAdd(&factors, p);
+        }
+    }
+    free(composite);
+    return factorsProduct(&factors);
+}
+
+hugeint *hugeint_primorial(hugeint_Uint n)
+{
+    if (n < 2) return hugeint_fromUint(1);
+
+    char *composite = sieve(n);
+    struct factors factors;
+    factorsInit(&factors);
+    for (hugeint_Uint p = 2; p <= n; ++p)
+    {
+        if (!composite[p]) factorsAdd(&factors, p);
+    }
+    free(composite);
+    return factorsProduct(&factors);
+}
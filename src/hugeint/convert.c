@@ -0,0 +1,851 @@
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "internal.h"
+
+#define HUGEINT_HEX_DIGITS (HUGEINT_ELEMENT_BITS / 4)
+#define HUGEINT_READ_CHUNK 4096
+#define HUGEINT_READ_BLOCK_LEVEL 10
+#define HUGEINT_MAX_RADIX 62
+#define HUGEINT_CONVERT_THRESHOLD 32
+#define HUGEINT_RECIPROCAL_THRESHOLD (4 * HUGEINT_ELEMENT_BITS)
+#define HUGEINT_MAX_POWERS (CHAR_BIT * sizeof(size_t))
+#define HUGEINT_PARALLEL_THRESHOLD 4096
+
+struct radixPower
+{
+    hugeint *power;
+    hugeint *reciprocal;
+    size_t bits;
+};
+
+struct radixPowers
+{
+    size_t count;
+    struct radixPower *powers;
+};
+
+struct parseJob
+{
+    const char *str;
+    size_t len;
+    unsigned int radix;
+    unsigned int chunkDigits;
+    atomic_uint *spare;
+    hugeint *result;
+};
+
+struct decimalReader
+{
+    char *digits;
+    size_t len;
+    size_t blockLen;
+    size_t count;
+    hugeint *blocks[HUGEINT_MAX_POWERS];
+    size_t levels[HUGEINT_MAX_POWERS];
+    atomic_uint spare;
+};
+
+struct toStringJob
+{
+    const hugeint *x;
+    unsigned int radix;
+    unsigned int chunkDigits;
+    size_t k;
+    const char *alphabet;
+    char *out;
+    size_t width;
+    atomic_uint *spare;
+};
+
+static struct radixPowers radixPowers[HUGEINT_MAX_RADIX + 1];
+static pthread_mutex_t radixPowersLock = PTHREAD_MUTEX_INITIALIZER;
+
+static const char lowerDigits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+static const char mixedDigits[] =
+    "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+static unsigned int radixChunk(unsigned int radix, hugeint_Uint *power)
+{
+    unsigned int digits = 1;
+    *power = radix;
+    while (*power <= UINTMAX_MAX / radix)
+    {
+        *power *= radix;
+        ++digits;
+    }
+    return digits;
+}
+
+static int digitValue(int c, unsigned int radix)
+{
+    int v;
+    if (c >= '0' && c <= '9') v = c - '0';
+    else if (c >= 'A' && c <= 'Z') v = c - 'A' + 10;
+    else if (c >= 'a' && c <= 'z') v = c - 'a' + (radix > 36 ? 36 : 10);
+    else return -1;
+    return v < (int)radix ? v : -1;
+}
+
+static const unsigned char hexValues[UCHAR_MAX + 1] = {
+    ['0'] = 0x10, ['1'] = 0x11, ['2'] = 0x12, ['3'] = 0x13, ['4'] = 0x14,
+    ['5'] = 0x15, ['6'] = 0x16, ['7'] = 0x17, ['8'] = 0x18, ['9'] = 0x19,
+    ['a'] = 0x1a, ['b'] = 0x1b, ['c'] = 0x1c, ['d'] = 0x1d, ['e'] = 0x1e,
+    ['f'] = 0x1f, ['A'] = 0x1a, ['B'] = 0x1b, ['C'] = 0x1c, ['D'] = 0x1d,
+    ['E'] = 0x1e, ['F'] = 0x1f
+};
+
+static const char hexDigits[] = "0123456789abcdef";
+
+static const char hexPairs[] =
+    "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+    "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+    "404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+    "606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+    "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+    "a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+    "c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+    "e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+static hugeint_Uint hexToLimb(const char *str, size_t len)
+{
+    hugeint_Uint v = 0;
+    for (size_t i = 0; i < len; ++i)
+    {
+        v = (v << 4) | (hexValues[(unsigned char)str[i]] & 0xf);
+    }
+    return v;
+}
+
+static void limbToHex(char *out, hugeint_Uint v)
+{
+    for (size_t i = HUGEINT_ELEMENT_BITS / 8; i > 0; --i)
+    {
+        memcpy(out + 2 * (i - 1), hexPairs + 2 * (v & 0xff), 2);
+        v >>= 8;
+    }
+}
+
+hugeint *hugeint_parseHex(const char *str)
+{
+    size_t len = strlen(str);
+    size_t n = len / HUGEINT_HEX_DIGITS;
+    size_t leading = len % HUGEINT_HEX_DIGITS;
+    size_t i = n;
+    if (leading) ++n;
+    if (!n) return hugeint_create();
+    hugeint *result = hugeint_createSized(n);
+    if (leading)
+    {
+        result->e[i] = hexToLimb(str, leading);
+        str += leading;
+    }
+    while (i)
+    {
+        --i;
+        result->e[i] = hexToLimb(str, HUGEINT_HEX_DIGITS);
+        str += HUGEINT_HEX_DIGITS;
+    }
+    hugeint_autoscale(&result);
+    return result;
+}
+
+static int isDecDigit(int c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static int isHexDigit(int c)
+{
+    return !!(hexValues[(unsigned char)c] & 0x10);
+}
+
+struct streamReader
+{
+    FILE *stream;
+    int (*isDigit)(int);
+    int seenDigit;
+};
+
+static size_t readStream(void *ctx, char *buf, size_t size)
+{
+    struct streamReader *sr = ctx;
+    size_t len = 0;
+    int c;
+    while (len < size && (c = getc(sr->stream)) != EOF)
+    {
+        if (sr->isDigit(c)) sr->seenDigit = 1;
+        else if (sr->seenDigit || (c != ' ' && c != '\t'))
+        {
+            ungetc(c, sr->stream);
+            break;
+        }
+        buf[len++] = c;
+    }
+    return len;
+}
+
+static const struct radixPower *radixPower(unsigned int radix, size_t k,
+        int withReciprocal);
+static void parseRec(void *arg);
+
+static hugeint *parseDecimalDigits(struct decimalReader *self)
+{
+    hugeint_Uint chunkPower;
+    struct parseJob job = {self->digits, self->len, 10,
+            radixChunk(10, &chunkPower), &self->spare, 0};
+    parseRec(&job);
+    self->len = 0;
+    return job.result;
+}
+
+static void pushDecimalBlock(struct decimalReader *self)
+{
+    hugeint *value = parseDecimalDigits(self);
+    size_t level = HUGEINT_READ_BLOCK_LEVEL;
+    while (self->count && self->levels[self->count - 1] == level)
+    {
+        hugeint *high = self->blocks[--self->count];
+        hugeint *merged = hugeint_mult(high, radixPower(10, level, 0)->power);
+        hugeint_free(high);
+        hugeint_addToSelf(&merged, value);
+        hugeint_free(value);
+        value = merged;
+        ++level;
+    }
+    self->blocks[self->count] = value;
+    self->levels[self->count++] = level;
+}
+
+hugeint *hugeint_readDecimalFrom(hugeint_Reader reader, void *ctx)
+{
+    char buf[HUGEINT_READ_CHUNK];
+    hugeint_Uint chunkPower;
+    struct decimalReader self;
+    self.blockLen = (size_t)radixChunk(10, &chunkPower)
+            << HUGEINT_READ_BLOCK_LEVEL;
+    self.digits = xmalloc(self.blockLen);
+    self.len = 0;
+    self.count = 0;
+    hugeint_spareThreadsInit(&self.spare);
+    hugeint_progressSuspend();
+    int skipping = 2;
+    size_t len;
+
+    while ((len = reader(ctx, buf, sizeof buf)) > 0)
+    {
+        size_t i = 0;
+        for (; skipping && i < len; ++i)
+        {
+            if (skipping == 2 && (buf[i] == ' ' || buf[i] == '\t')) continue;
+            if (buf[i] != '0') break;
+            skipping = 1;
+        }
+        if (i == len) continue;
+        skipping = 0;
+        for (; i < len && isDecDigit(buf[i]); ++i)
+        {
+            self.digits[self.len++] = buf[i];
+            if (self.len == self.blockLen) pushDecimalBlock(&self);
+        }
+        if (i < len) break;
+    }
+
+    hugeint *result = self.count ? self.blocks[0] : hugeint_create();
+    for (size_t i = 1; i < self.count; ++i)
+    {
+        hugeint *high = result;
+        result = hugeint_mult(high, radixPower(10, self.levels[i], 0)->power);
+        hugeint_free(high);
+        hugeint_addToSelf(&result, self.blocks[i]);
+        hugeint_free(self.blocks[i]);
+    }
+    if (self.len)
+    {
+        hugeint *scale = hugeint_powUint(10, self.len);
+        hugeint *tail = parseDecimalDigits(&self);
+        hugeint *high = result;
+        result = hugeint_mult(high, scale);
+        hugeint_free(high);
+        hugeint_free(scale);
+        hugeint_addToSelf(&result, tail);
+        hugeint_free(tail);
+    }
+    hugeint_progressResume();
+    free(self.digits);
+    return result;
+}
+
+hugeint *hugeint_readHexFrom(hugeint_Reader reader, void *ctx)
+{
+    char buf[HUGEINT_READ_CHUNK];
+    hugeint *result = hugeint_create();
+    hugeint_Uint acc = 0;
+    unsigned int accBits = 0;
+    size_t n = 0;
+    int skipping = 2;
+    size_t len;
+
+    while ((len = reader(ctx, buf, sizeof buf)) > 0)
+    {
+        size_t i = 0;
+        for (; skipping && i < len; ++i)
+        {
+            if (skipping == 2 && (buf[i] == ' ' || buf[i] == '\t')) continue;
+            if (buf[i] != '0') break;
+            skipping = 1;
+        }
+        if (i == len) continue;
+        skipping = 0;
+        for (; i < len && isHexDigit(buf[i]); ++i)
+        {
+            acc = (acc << 4) | (hexValues[(unsigned char)buf[i]] & 0xf);
+            accBits += 4;
+            if (accBits == HUGEINT_ELEMENT_BITS)
+            {
+                if (n == result->n) result = hugeint_scale(result, n + 1);
+                result->e[n++] = acc;
+                acc = 0;
+                accBits = 0;
+            }
+        }
+        if (i < len) break;
+    }
+
+    for (size_t i = 0; i < n / 2; ++i)
+    {
+        hugeint_Uint tmp = result->e[i];
+        result->e[i] = result->e[n - 1 - i];
+        result->e[n - 1 - i] = tmp;
+    }
+    if (n) hugeint_shiftLeft(&result, accBits);
+    result->e[0] |= acc;
+    return result;
+}
+
+hugeint *hugeint_readDecimal(FILE *stream)
+{
+    struct streamReader sr = { stream, isDecDigit, 0 };
+    return hugeint_readDecimalFrom(readStream, &sr);
+}
+
+hugeint *hugeint_readHex(FILE *stream)
+{
+    struct streamReader sr = { stream, isHexDigit, 0 };
+    return hugeint_readHexFrom(readStream, &sr);
+}
+
+static hugeint *reciprocal(const hugeint *p, size_t m)
+{
+    hugeint *target = hugeint_fromUint(1);
+    hugeint_shiftLeft(&target, 2 * m);
+    if (m <= HUGEINT_RECIPROCAL_THRESHOLD)
+    {
+        hugeint *r = hugeint_div(target, p, 0);
+        hugeint_free(target);
+        return r;
+    }
+
+    size_t h = m / 2 + 8;
+    hugeint *ph = hugeint_clone(p);
+    hugeint_shiftRight(&ph, m - h);
+    hugeint *rh = reciprocal(ph, h);
+    hugeint_free(ph);
+
+    hugeint *sq = hugeint_mult(rh, rh);
+    hugeint *t = hugeint_mult(sq, p);
+    hugeint_free(sq);
+    hugeint_shiftRight(&t, 2 * h);
+    hugeint_shiftLeft(&rh, m - h + 1);
+    hugeint_subFromSelf(&rh, t);
+    hugeint_free(t);
+
+    hugeint *prod = hugeint_mult(p, rh);
+    while (hugeint_compare(prod, target) > 0)
+    {
+        hugeint_subFromSelf(&prod, p);
+        hugeint_decrement(&rh);
+    }
+    for (;;)
+    {
+        hugeint_addToSelf(&prod, p);
+        if (hugeint_compare(prod, target) > 0) break;
+        hugeint_increment(&rh);
+    }
+    hugeint_free(prod);
+    hugeint_free(target);
+    return rh;
+}
+
+static size_t convertCost(size_t n, unsigned int mults)
+{
+    if (n <= HUGEINT_CONVERT_THRESHOLD) return n * n / 2;
+    return mults * hugeint_multCost(n / 2, n / 2)
+            + 2 * convertCost(n / 2, mults);
+}
+
+static size_t reciprocalCost(size_t n)
+{
+    if (n <= HUGEINT_RECIPROCAL_THRESHOLD / HUGEINT_ELEMENT_BITS) return n * n;
+    return reciprocalCost(n / 2) + hugeint_multCost(n / 2, n / 2)
+            + 2 * hugeint_multCost(n, n);
+}
+
+static size_t powersCost(unsigned int radix, size_t k)
+{
+    struct radixPowers *rp = &radixPowers[radix];
+    size_t cost = 0;
+    size_t limbs = 1;
+    pthread_mutex_lock(&radixPowersLock);
+    for (size_t i = 1; i <= k; ++i)
+    {
+        int cached = i < rp->count;
+        if (!cached) cost += hugeint_multCost(limbs, limbs);
+        limbs *= 2;
+        if (!cached || !rp->powers[i].reciprocal) cost += reciprocalCost(limbs);
+    }
+    pthread_mutex_unlock(&radixPowersLock);
+    return cost;
+}
+
+static size_t toStringCost(size_t limbs, unsigned int radix)
+{
+    if (limbs <= HUGEINT_CONVERT_THRESHOLD) return convertCost(limbs, 2);
+    size_t k = 1;
+    while (limbs >> (k + 1)) ++k;
+    return convertCost(limbs, 2) + powersCost(radix, k);
+}
+
+static const struct radixPower *radixPower(unsigned int radix, size_t k,
+        int withReciprocal)
+{
+    struct radixPowers *rp = &radixPowers[radix];
+    pthread_mutex_lock(&radixPowersLock);
+    hugeint_progressSuspend();
+    if (!rp->powers)
+    {
+        hugeint_Uint chunkPower;
+        radixChunk(radix, &chunkPower);
+        rp->powers = xmalloc(HUGEINT_MAX_POWERS * sizeof *rp->powers);
+        rp->powers[0].power = hugeint_fromUint(chunkPower);
+        rp->powers[0].reciprocal = 0;
+        rp->powers[0].bits = hugeint_bitLength(rp->powers[0].power);
+        rp->count = 1;
+    }
+    while (rp->count <= k)
+    {
+        struct radixPower *prev = &rp->powers[rp->count - 1];
+        struct radixPower *next = &rp->powers[rp->count++];
+        next->power = hugeint_mult(prev->power, prev->power);
+        next->reciprocal = 0;
+        next->bits = hugeint_bitLength(next->power);
+    }
+    struct radixPower *p = &rp->powers[k];
+    if (withReciprocal && !p->reciprocal)
+    {
+        p->reciprocal = reciprocal(p->power, p->bits);
+    }
+    hugeint_progressResume();
+    pthread_mutex_unlock(&radixPowersLock);
+    return p;
+}
+
+static hugeint *divideByPower(const hugeint *x, const struct radixPower *p,
+        hugeint **remainder)
+{
+    hugeint *q = hugeint_clone(x);
+    hugeint_shiftRight(&q, p->bits - 1);
+    hugeint *tmp = hugeint_mult(q, p->reciprocal);
+    hugeint_free(q);
+    hugeint_shiftRight(&tmp, p->bits + 1);
+    q = tmp;
+    tmp = hugeint_mult(q, p->power);
+    hugeint *r = hugeint_sub(x, tmp);
+    hugeint_free(tmp);
+    while (!hugeint_progressAborted() && hugeint_compare(r, p->power) >= 0)
+    {
+        hugeint_subFromSelf(&r, p->power);
+        hugeint_increment(&q);
+    }
+    *remainder = r;
+    return q;
+}
+
+static hugeint *parsePow2(const char *str, size_t len, unsigned int radix)
+{
+    unsigned int bits = 0;
+    while ((1U << bits) < radix) ++bits;
+    hugeint *result = hugeint_createSized(
+            (len * bits + HUGEINT_ELEMENT_BITS - 1) / HUGEINT_ELEMENT_BITS);
+    for (size_t i = 0; i < len; ++i)
+    {
+        hugeint_Uint v = digitValue(str[len - 1 - i], radix);
+        size_t pos = i * bits;
+        size_t limb = pos / HUGEINT_ELEMENT_BITS;
+        unsigned int shift = pos % HUGEINT_ELEMENT_BITS;
+        result->e[limb] |= v << shift;
+        if (shift + bits > HUGEINT_ELEMENT_BITS)
+        {
+            result->e[limb + 1] |= v >> (HUGEINT_ELEMENT_BITS - shift);
+        }
+    }
+    hugeint_autoscale(&result);
+    return result;
+}
+
+static hugeint *parseBasecase(const char *str, size_t len, unsigned int radix)
+{
+    hugeint_Uint chunkPower;
+    unsigned int chunkDigits = radixChunk(radix, &chunkPower);
+    hugeint *result = hugeint_createSized(len / chunkDigits + 1);
+    result->n = 1;
+
+    size_t head = len % chunkDigits;
+    if (!head) head = chunkDigits;
+    for (size_t i = 0; i < head; ++i)
+    {
+        result->e[0] = result->e[0] * radix + digitValue(str[i], radix);
+    }
+    for (str += head, len -= head; len; str += chunkDigits, len -= chunkDigits)
+    {
+        hugeint_Uint acc = 0;
+        for (unsigned int i = 0; i < chunkDigits; ++i)
+        {
+            acc = acc * radix + digitValue(str[i], radix);
+        }
+        hugeint_multUintToSelf(&result, chunkPower);
+        hugeint_addUintToSelf(&result, acc);
+    }
+    hugeint_progressAdd(result->n * result->n / 2);
+    return result;
+}
+
+static void parseRec(void *arg)
+{
+    struct parseJob *job = arg;
+    if (job->len <= job->chunkDigits * HUGEINT_CONVERT_THRESHOLD)
+    {
+        job->result = parseBasecase(job->str, job->len, job->radix);
+        return;
+    }
+
+    size_t k = 0;
+    while ((size_t)job->chunkDigits << (k + 1) < job->len) ++k;
+    size_t lowLen = (size_t)job->chunkDigits << k;
+
+    struct parseJob high = *job;
+    struct parseJob low = *job;
+    high.len -= lowLen;
+    low.str += high.len;
+    low.len = lowLen;
+    struct hugeint_fork fork;
+    hugeint_forkStart(&fork, lowLen / job->chunkDigits
+            >= HUGEINT_PARALLEL_THRESHOLD ? job->spare : 0, parseRec, &high);
+    parseRec(&low);
+    hugeint_forkJoin(&fork);
+    if (hugeint_progressAborted())
+    {
+        hugeint_free(high.result);
+        hugeint_free(low.result);
+        job->result = hugeint_create();
+        return;
+    }
+
+    job->result = hugeint_mult(high.result, radixPower(job->radix, k, 0)->power);
+    hugeint_free(high.result);
+    hugeint_addToSelf(&job->result, low.result);
+    hugeint_free(low.result);
+}
+
+hugeint *hugeint_parseBase(const char *str, unsigned int radix)
+{
+    if (radix < 2 || radix > HUGEINT_MAX_RADIX) return 0;
+    while (*str == ' ' || *str == '\t') ++str;
+    while (*str == '0') ++str;
+    size_t len = 0;
+    while (digitValue(str[len], radix) >= 0) ++len;
+    if (!len) return hugeint_create();
+    if (!(radix & (radix - 1))) return parsePow2(str, len, radix);
+
+    hugeint_Uint chunkPower;
+    struct parseJob job = {str, len, radix, radixChunk(radix, &chunkPower),
+            0, 0};
+    hugeint_progressEnter(convertCost(len / job.chunkDigits + 1, 1));
+    if (hugeint_threads() > 1)
+    {
+        size_t k = 0;
+        while ((size_t)job.chunkDigits << (k + 1) < len) ++k;
+        radixPower(radix, k, 0);
+    }
+    atomic_uint spare;
+    hugeint_spareThreadsInit(&spare);
+    job.spare = &spare;
+    parseRec(&job);
+    if (hugeint_progressLeave())
+    {
+        hugeint_free(job.result);
+        return 0;
+    }
+    return job.result;
+}
+
+hugeint *hugeint_parse(const char *str)
+{
+    return hugeint_parseBase(str, 10);
+}
+
+static size_t digitsUpperBound(const hugeint *self, unsigned int radix)
+{
+    if (hugeint_isZero(self)) return 1;
+    if (!(radix & (radix - 1)))
+    {
+        unsigned int bits = 0;
+        while ((1U << bits) < radix) ++bits;
+        return (hugeint_bitLength(self) + bits - 1) / bits;
+    }
+    hugeint_Uint chunkPower;
+    unsigned int chunkDigits = radixChunk(radix, &chunkPower);
+    size_t chunkBits = HUGEINT_ELEMENT_BITS - 1 - leadingZeros(chunkPower);
+    return chunkDigits
+            * ((hugeint_bitLength(self) + chunkBits - 1) / chunkBits);
+}
+
+size_t hugeint_decimalDigitsUpperBound(const hugeint *self)
+{
+    return digitsUpperBound(self, 10);
+}
+
+size_t hugeint_hexDigits(const hugeint *self)
+{
+    size_t lead = 0;
+    for (hugeint_Uint w = self->e[self->n - 1]; w; w >>= 4) ++lead;
+    if (!lead) lead = 1;
+    return lead + (self->n - 1) * HUGEINT_HEX_DIGITS;
+}
+
+double hugeint_toDouble(const hugeint *self)
+{
+    size_t n = self->n;
+    double result = (double)self->e[n - 1];
+    if (n == 1) return result;
+    result = ldexp(result, HUGEINT_ELEMENT_BITS) + (double)self->e[n - 2];
+    if ((n - 2) * HUGEINT_ELEMENT_BITS > (size_t)DBL_MAX_EXP) return HUGE_VAL;
+    return ldexp(result, (int)((n - 2) * HUGEINT_ELEMENT_BITS));
+}
+
+double hugeint_log2(const hugeint *self)
+{
+    size_t bits = hugeint_bitLength(self);
+    if (bits <= HUGEINT_ELEMENT_BITS) return log2((double)self->e[0]);
+    size_t shift = bits - HUGEINT_ELEMENT_BITS;
+    size_t limb = shift / HUGEINT_ELEMENT_BITS;
+    unsigned int offset = shift % HUGEINT_ELEMENT_BITS;
+    hugeint_Uint top = self->e[limb] >> offset;
+    if (offset) top |= self->e[limb + 1] << (HUGEINT_ELEMENT_BITS - offset);
+    return (double)shift + log2((double)top);
+}
+
+static void toStringPow2(const hugeint *self, unsigned int radix,
+        const char *alphabet, char *out, size_t len)
+{
+    unsigned int bits = 0;
+    while ((1U << bits) < radix) ++bits;
+    hugeint_Uint mask = radix - 1;
+    for (size_t i = 0; i < len; ++i)
+    {
+        size_t pos = i * bits;
+        size_t limb = pos / HUGEINT_ELEMENT_BITS;
+        unsigned int shift = pos % HUGEINT_ELEMENT_BITS;
+        hugeint_Uint v = self->e[limb] >> shift;
+        if (shift + bits > HUGEINT_ELEMENT_BITS && limb + 1 < self->n)
+        {
+            v |= self->e[limb + 1] << (HUGEINT_ELEMENT_BITS - shift);
+        }
+        out[len - 1 - i] = alphabet[v & mask];
+    }
+}
+
+static void toStringBasecase(const hugeint *x, unsigned int radix,
+        const char *alphabet, char *out, size_t width)
+{
+    hugeint_Uint chunkPower;
+    unsigned int chunkDigits = radixChunk(radix, &chunkPower);
+    hugeint_UintDivisor divisor;
+    hugeint_prepareUintDivisor(&divisor, chunkPower);
+    size_t n = x->n;
+    hugeint_Uint *e = xmalloc(n * sizeof *e);
+    memcpy(e, x->e, n * sizeof *e);
+    if (!e[n-1]) --n;
+
+    char *p = out + width;
+    while (n)
+    {
+        hugeint_Uint r = hugeint_limbsDivUint(e, e, n, &divisor);
+        if (!e[n-1]) --n;
+        for (unsigned int i = 0; i < chunkDigits && p > out; ++i)
+        {
+            *--p = alphabet[r % radix];
+            r /= radix;
+        }
+    }
+    free(e);
+    if (p > out) memset(out, '0', p - out);
+    hugeint_progressAdd(x->n * x->n / 2);
+}
+
+static void toStringRec(void *arg)
+{
+    struct toStringJob *job = arg;
+    while (job->k && job->width <= (size_t)job->chunkDigits << job->k)
+    {
+        --job->k;
+    }
+    if (!job->k || job->x->n <= HUGEINT_CONVERT_THRESHOLD)
+    {
+        toStringBasecase(job->x, job->radix, job->alphabet, job->out,
+                job->width);
+        return;
+    }
+
+    struct toStringJob high = *job;
+    struct toStringJob low = *job;
+    hugeint *r;
+    hugeint *q = divideByPower(job->x, radixPower(job->radix, job->k, 1), &r);
+    if (hugeint_progressAborted())
+    {
+        hugeint_free(q);
+        hugeint_free(r);
+        return;
+    }
+    high.x = q;
+    low.x = r;
+    high.k = low.k = job->k - 1;
+    low.width = (size_t)job->chunkDigits << job->k;
+    high.width = job->width - low.width;
+    low.out += high.width;
+    struct hugeint_fork fork;
+    hugeint_forkStart(&fork, job->x->n >= HUGEINT_PARALLEL_THRESHOLD
+            ? job->spare : 0, toStringRec, &high);
+    toStringRec(&low);
+    hugeint_forkJoin(&fork);
+    hugeint_free(q);
+    hugeint_free(r);
+}
+
+static size_t splitLevel(const hugeint *self, unsigned int radix,
+        hugeint_Uint chunkPower)
+{
+    double bits = hugeint_log2(self);
+    double step = log2((double)chunkPower);
+    size_t k = 1;
+    for (;;)
+    {
+        double next = ldexp(step, (int)k + 1);
+        if (bits < next - 1) break;
+        if (bits < next + 1 && hugeint_compare(self,
+                    radixPower(radix, k + 1, 0)->power) < 0) break;
+        ++k;
+    }
+    return k;
+}
+
+static size_t toStringInto(const hugeint *self, unsigned int radix,
+        char *out)
+{
+    const char *alphabet = radix > 36 ? mixedDigits : lowerDigits;
+    size_t width = digitsUpperBound(self, radix);
+    if (hugeint_isZero(self))
+    {
+        out[0] = '0';
+        out[1] = 0;
+        return 1;
+    }
+    if (!(radix & (radix - 1)))
+    {
+        toStringPow2(self, radix, alphabet, out, width);
+        out[width] = 0;
+        return width;
+    }
+
+    if (self->n <= HUGEINT_CONVERT_THRESHOLD)
+    {
+        toStringBasecase(self, radix, alphabet, out, width);
+    }
+    else
+    {
+        hugeint_progressEnter(toStringCost(self->n, radix));
+        hugeint_Uint chunkPower;
+        unsigned int chunkDigits = radixChunk(radix, &chunkPower);
+        size_t k = splitLevel(self, radix, chunkPower);
+        if (hugeint_threads() > 1)
+        {
+            for (size_t i = 1; i <= k; ++i) radixPower(radix, i, 1);
+        }
+        atomic_uint spare;
+        hugeint_spareThreadsInit(&spare);
+        struct toStringJob job = {self, radix, chunkDigits, k, alphabet, out,
+                width, &spare};
+        toStringRec(&job);
+        if (hugeint_progressLeave()) return 0;
+    }
+
+    size_t i = 0;
+    while (out[i] == '0') ++i;
+    width -= i;
+    memmove(out, out + i, width);
+    out[width] = 0;
+    return width;
+}
+
+char *hugeint_toStringBase(const hugeint *self, unsigned int radix)
+{
+    if (radix < 2 || radix > HUGEINT_MAX_RADIX) return 0;
+    char *result = xmalloc(digitsUpperBound(self, radix) + 1);
+    if (!toStringInto(self, radix, result))
+    {
+        free(result);
+        return 0;
+    }
+    return result;
+}
+
+char *hugeint_toString(const hugeint *self)
+{
+    return hugeint_toStringBase(self, 10);
+}
+
+size_t hugeint_toStringInto(const hugeint *self, char *buf)
+{
+    return toStringInto(self, 10, buf);
+}
+
+size_t hugeint_toHexStringInto(const hugeint *self, char *buf)
+{
+    size_t top = self->n - 1;
+    size_t len = hugeint_hexDigits(self);
+    size_t lead = len - top * HUGEINT_HEX_DIGITS;
+    buf[len] = 0;
+
+    hugeint_Uint v = self->e[top];
+    for (size_t j = lead; j > 0; --j)
+    {
+        buf[j - 1] = hexDigits[v & 0xf];
+        v >>= 4;
+    }
+    char *out = buf + lead;
+    for (size_t i = top; i > 0; --i)
+    {
+        limbToHex(out, self->e[i - 1]);
+        out += HUGEINT_HEX_DIGITS;
+    }
+    return len;
+}
+
+char *hugeint_toHexString(const hugeint *self)
+{
+    char *result = xmalloc(hugeint_hexDigits(self) + 1);
+    hugeint_toHexStringInto(self, result);
+    return result;
+}
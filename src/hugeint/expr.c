@@ -0,0 +1,439 @@
+#include <string.h>
+
+#include "internal.h"
+
+#define HUGEINT_EXPR_PARALLEL_LIMBS 1024
+
+enum exprOp
+{
+    EXPR_VALUE,
+    EXPR_ADD,
+    EXPR_SUB,
+    EXPR_MULT,
+    EXPR_DIV
+};
+
+struct hugeint_expr
+{
+    atomic_size_t refs;
+    enum exprOp op;
+    const hugeint *value;
+    hugeint *constant;
+    hugeint_expr *a;
+    hugeint_expr *b;
+    pthread_mutex_t lock;
+    unsigned long mark;
+    size_t uses;
+    size_t limbs;
+    atomic_size_t pending;
+    int evaluated;
+    hugeint *result;
+};
+
+struct operand
+{
+    hugeint_expr *node;
+    atomic_uint *spare;
+    hugeint *value;
+    hugeint *owned;
+};
+
+struct operands
+{
+    size_t count;
+    size_t size;
+    struct operand *items;
+};
+
+struct exprFrame
+{
+    hugeint_expr *node;
+    int expanded;
+    struct operand *target;
+    struct operands operands;
+    struct hugeint_fork *forks;
+};
+
+struct exprStack
+{
+    size_t count;
+    size_t size;
+    struct exprFrame *items;
+};
+
+static atomic_ulong generation;
+
+static hugeint_expr *create(enum exprOp op, hugeint_expr *a, hugeint_expr *b)
+{
+    hugeint_expr *self = xmalloc(sizeof *self);
+    atomic_init(&self->refs, 1);
+    self->op = op;
+    self->value = 0;
+    self->constant = 0;
+    self->a = a;
+    self->b = b;
+    pthread_mutex_init(&self->lock, 0);
+    self->mark = 0;
+    return self;
+}
+
+hugeint_expr *hugeint_exprValue(const hugeint *value)
+{
+    hugeint_expr *self = create(EXPR_VALUE, 0, 0);
+    self->value = value;
+    return self;
+}
+
+hugeint_expr *hugeint_exprUint(hugeint_Uint value)
+{
+    hugeint_expr *self = create(EXPR_VALUE, 0, 0);
+    self->constant = hugeint_fromUint(value);
+    self->value = self->constant;
+    return self;
+}
+
+hugeint_expr *hugeint_exprAdd(hugeint_expr *a, hugeint_expr *b)
+{
+    return create(EXPR_ADD, a, b);
+}
+
+hugeint_expr *hugeint_exprSub(hugeint_expr *minuend, hugeint_expr *subtrahend)
+{
+    return create(EXPR_SUB, minuend, subtrahend);
+}
+
+hugeint_expr *hugeint_exprMult(hugeint_expr *a, hugeint_expr *b)
+{
+    return create(EXPR_MULT, a, b);
+}
+
+hugeint_expr *hugeint_exprDiv(hugeint_expr *dividend, hugeint_expr *divisor)
+{
+    return create(EXPR_DIV, dividend, divisor);
+}
+
+static void stackPush(struct exprStack *self, hugeint_expr *node,
+        int expanded)
+{
+    if (self->count == self->size)
+    {
+        self->size = self->size ? 2 * self->size : 16;
+        self->items = xrealloc(self->items, self->size * sizeof *self->items);
+    }
+    struct exprFrame *frame = &self->items[self->count++];
+    frame->node = node;
+    frame->expanded = expanded;
+    frame->target = 0;
+    frame->operands.count = 0;
+    frame->operands.size = 0;
+    frame->operands.items = 0;
+    frame->forks = 0;
+}
+
+hugeint_expr *hugeint_exprClone(hugeint_expr *self)
+{
+    atomic_fetch_add_explicit(&self->refs, 1, memory_order_relaxed);
+    return self;
+}
+
+void hugeint_exprFree(hugeint_expr *self)
+{
+    struct exprStack stack = { 0, 0, 0 };
+    while (self)
+    {
+        if (atomic_fetch_sub_explicit(&self->refs, 1, memory_order_acq_rel)
+                == 1)
+        {
+            if (self->a) stackPush(&stack, self->a, 0);
+            if (self->b) stackPush(&stack, self->b, 0);
+            hugeint_free(self->constant);
+            pthread_mutex_destroy(&self->lock);
+            free(self);
+        }
+        self = stack.count ? stack.items[--stack.count].node : 0;
+    }
+    free(stack.items);
+}
+
+static void measure(hugeint_expr *self)
+{
+    size_t a = self->a->limbs;
+    size_t b = self->b->limbs;
+    switch (self->op)
+    {
+        case EXPR_ADD:
+            self->limbs = (a > b ? a : b) + 1;
+            break;
+        case EXPR_SUB:
+            self->limbs = a;
+            break;
+        case EXPR_MULT:
+            self->limbs = a + b;
+            break;
+        default:
+            self->limbs = a > b ? a - b + 1 : 1;
+    }
+}
+
+static void countUses(hugeint_expr *self, unsigned long mark)
+{
+    struct exprStack stack = { 0, 0, 0 };
+    stackPush(&stack, self, 0);
+    while (stack.count)
+    {
+        struct exprFrame frame = stack.items[--stack.count];
+        hugeint_expr *node = frame.node;
+        if (frame.expanded)
+        {
+            measure(node);
+            continue;
+        }
+        if (node->mark != mark)
+        {
+            node->mark = mark;
+            node->uses = 0;
+            node->evaluated = 0;
+            node->result = 0;
+            if (node->op == EXPR_VALUE) node->limbs = node->value->n;
+            else
+            {
+                stackPush(&stack, node, 1);
+                stackPush(&stack, node->b, 0);
+                stackPush(&stack, node->a, 0);
+            }
+        }
+        atomic_store(&node->pending, ++node->uses);
+    }
+    free(stack.items);
+}
+
+static void push(struct operands *self, hugeint_expr *node)
+{
+    if (self->count == self->size)
+    {
+        self->size = self->size ? 2 * self->size : 4;
+        self->items = xrealloc(self->items, self->size * sizeof *self->items);
+    }
+    struct operand *item = &self->items[self->count++];
+    item->node = node;
+    item->value = 0;
+    item->owned = 0;
+}
+
+static void gather(struct operands *self, hugeint_expr *node, enum exprOp op)
+{
+    struct exprStack stack = { 0, 0, 0 };
+    stackPush(&stack, node->b, 0);
+    stackPush(&stack, node->a, 0);
+    while (stack.count)
+    {
+        hugeint_expr *next = stack.items[--stack.count].node;
+        if (next->op == op && next->uses == 1)
+        {
+            stackPush(&stack, next->b, 0);
+            stackPush(&stack, next->a, 0);
+        }
+        else push(self, next);
+    }
+    free(stack.items);
+}
+
+static void evaluate(struct operand *root);
+
+static void evalOperand(void *arg)
+{
+    evaluate(arg);
+}
+
+static void release(struct operand *self)
+{
+    hugeint_expr *node = self->node;
+    if (self->owned) hugeint_free(self->owned);
+    else if (node->op != EXPR_VALUE && node->uses > 1
+            && atomic_fetch_sub(&node->pending, 1) == 1)
+    {
+        hugeint_free(node->result);
+    }
+}
+
+static hugeint *sum(struct operands *self)
+{
+    size_t acc = self->count;
+    for (size_t i = 0; i < self->count; ++i)
+    {
+        const hugeint *owned = self->items[i].owned;
+        if (owned && (acc == self->count
+                    || owned->n > self->items[acc].owned->n)) acc = i;
+    }
+    if (acc == self->count)
+    {
+        hugeint **values = xmalloc(self->count * sizeof *values);
+        for (size_t i = 0; i < self->count; ++i)
+        {
+            values[i] = self->items[i].value;
+        }
+        hugeint *result = hugeint_sumArray(self->count, values);
+        free(values);
+        return result;
+    }
+
+    hugeint *result = self->items[acc].owned;
+    self->items[acc].owned = 0;
+    for (size_t i = 0; i < self->count; ++i)
+    {
+        if (i != acc) hugeint_addToSelf(&result, self->items[i].value);
+    }
+    return result;
+}
+
+static hugeint *product(struct operands *self)
+{
+    hugeint **values = xmalloc(self->count * sizeof *values);
+    for (size_t i = 0; i < self->count; ++i)
+    {
+        values[i] = self->items[i].value;
+    }
+    hugeint *result = hugeint_productArray(self->count, values);
+    free(values);
+    return result;
+}
+
+static hugeint *difference(struct operands *self)
+{
+    struct operand *minuend = &self->items[0];
+    if (!minuend->owned) return hugeint_sub(minuend->value,
+            self->items[1].value);
+    hugeint *result = minuend->owned;
+    minuend->owned = 0;
+    hugeint_subFromSelf(&result, self->items[1].value);
+    return result;
+}
+
+static int begin(struct exprFrame *frame)
+{
+    hugeint_expr *node = frame->node;
+    if (node->uses == 1) return 1;
+    pthread_mutex_lock(&node->lock);
+    if (!node->evaluated) return 1;
+    pthread_mutex_unlock(&node->lock);
+    frame->target->value = node->result;
+    return 0;
+}
+
+static void expand(struct exprStack *stack, atomic_uint *spare)
+{
+    size_t index = stack->count - 1;
+    struct exprFrame *frame = &stack->items[index];
+    struct operands *operands = &frame->operands;
+    hugeint_expr *node = frame->node;
+    if (node->op == EXPR_ADD || node->op == EXPR_MULT)
+    {
+        gather(operands, node, node->op);
+    }
+    else
+    {
+        push(operands, node->a);
+        push(operands, node->b);
+    }
+    frame->expanded = 1;
+    frame->forks = xmalloc(operands->count * sizeof *frame->forks);
+    memset(frame->forks, 0, operands->count * sizeof *frame->forks);
+
+    for (size_t i = operands->count; i > 0; --i)
+    {
+        frame = &stack->items[index];
+        struct operand *item = &frame->operands.items[i - 1];
+        item->spare = spare;
+        if (item->node->op == EXPR_VALUE)
+        {
+            item->value = (hugeint *)item->node->value;
+            continue;
+        }
+        if (i < frame->operands.count
+                && item->node->limbs >= HUGEINT_EXPR_PARALLEL_LIMBS
+                && hugeint_forkTry(&frame->forks[i - 1], spare,
+                    evalOperand, item)) continue;
+        stackPush(stack, item->node, 0);
+        stack->items[stack->count - 1].target = item;
+    }
+}
+
+static hugeint *combine(struct exprFrame *frame)
+{
+    struct operands *operands = &frame->operands;
+    int ok = 1;
+    for (size_t i = 0; i < operands->count; ++i)
+    {
+        hugeint_forkJoin(&frame->forks[i]);
+        if (!operands->items[i].value) ok = 0;
+    }
+
+    hugeint *result = 0;
+    if (ok)
+    {
+        switch (frame->node->op)
+        {
+            case EXPR_ADD:
+                result = sum(operands);
+                break;
+            case EXPR_SUB:
+                result = difference(operands);
+                break;
+            case EXPR_MULT:
+                result = product(operands);
+                break;
+            default:
+                result = hugeint_div(operands->items[0].value,
+                        operands->items[1].value, 0);
+        }
+    }
+    for (size_t i = 0; i < operands->count; ++i)
+    {
+        release(&operands->items[i]);
+    }
+    free(operands->items);
+    free(frame->forks);
+    return result;
+}
+
+static void evaluate(struct operand *root)
+{
+    struct exprStack stack = { 0, 0, 0 };
+    stackPush(&stack, root->node, 0);
+    stack.items[0].target = root;
+    while (stack.count)
+    {
+        struct exprFrame *frame = &stack.items[stack.count - 1];
+        if (!frame->expanded)
+        {
+            if (begin(frame)) expand(&stack, root->spare);
+            else --stack.count;
+            continue;
+        }
+
+        hugeint *result = combine(frame);
+        hugeint_expr *node = frame->node;
+        struct operand *target = frame->target;
+        --stack.count;
+        target->value = result;
+        if (node->uses == 1) target->owned = result;
+        else
+        {
+            node->result = result;
+            node->evaluated = 1;
+            pthread_mutex_unlock(&node->lock);
+        }
+    }
+    free(stack.items);
+}
+
+hugeint *hugeint_exprEval(hugeint_expr *self)
+{
+    if (self->op == EXPR_VALUE) return hugeint_clone(self->value);
+    countUses(self, atomic_fetch_add(&generation, 1) + 1);
+    atomic_uint spare;
+    hugeint_spareThreadsInit(&spare);
+    struct operand root = { self, &spare, 0, 0 };
+    evaluate(&root);
+    return root.owned;
+}
@@ -0,0 +1,89 @@
+#include "internal.h"
+
+static hugeint *fibPair(hugeint_Uint n, hugeint **previous)
+{
+    hugeint *f = hugeint_fromUint(1);
+    hugeint *g = hugeint_create();
+    hugeint_Uint k = 1;
+    unsigned int bit = HUGEINT_ELEMENT_BITS - 1 - leadingZeros(n);
+
+    while (bit--)
+    {
+        hugeint *fSquare = hugeint_mult(f, f);
+        hugeint *gSquare = hugeint_mult(g, g);
+        hugeint_free(f);
+        hugeint_free(g);
+        if (hugeint_progressAborted())
+        {
+            hugeint_free(fSquare);
+            hugeint_free(gSquare);
+            f = hugeint_create();
+            g = hugeint_create();
+            break;
+        }
+
+        hugeint *odd = hugeint_clone(fSquare);
+        hugeint_shiftLeft(&odd, 2);
+        hugeint_subFromSelf(&odd, gSquare);
+        if (k & 1U) hugeint_subUintFromSelf(&odd, 2);
+        else hugeint_addUintToSelf(&odd, 2);
+        hugeint_addToSelf(&fSquare, gSquare);
+        hugeint_free(gSquare);
+
+        hugeint *even = hugeint_sub(odd, fSquare);
+        if (n >> bit & 1U)
+        {
+            f = odd;
+            g = even;
+            hugeint_free(fSquare);
+            k = 2 * k + 1;
+        }
+        else
+        {
+            f = even;
+            g = fSquare;
+            hugeint_free(odd);
+            k = 2 * k;
+        }
+    }
+
+    *previous = g;
+    return f;
+}
+
+static size_t fibCost(hugeint_Uint n)
+{
+    return 2 * hugeint_squaringCost(n / 92 + 1);
+}
+
+hugeint *hugeint_fib(hugeint_Uint n)
+{
+    if (!n) return hugeint_create();
+    hugeint *previous;
+    hugeint_progressEnter(fibCost(n));
+    hugeint *result = fibPair(n, &previous);
+    hugeint_free(previous);
+    if (hugeint_progressLeave())
+    {
+        hugeint_free(result);
+        return 0;
+    }
+    return result;
+}
+
+hugeint *hugeint_lucas(hugeint_Uint n)
+{
+    if (!n) return hugeint_fromUint(2);
+    hugeint *previous;
+    hugeint_progressEnter(fibCost(n));
+    hugeint *result = fibPair(n, &previous);
+    hugeint_shiftLeft(&previous, 1);
+    hugeint_addToSelf(&result, previous);
+    hugeint_free(previous);
+    if (hugeint_progressLeave())
+    {
+        hugeint_free(result);
+        return 0;
+    }
+    return result;
+}
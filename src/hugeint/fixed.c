@@ -0,0 +1,147 @@
+#include <string.h>
+
+#include "internal.h"
+#include "fixed.h"
+
+static inline void mulLow(hugeint_Uint *r, const hugeint_Uint *a,
+        const hugeint_Uint *b, size_t n)
+{
+    memset(r, 0, n * sizeof *r);
+    for (size_t i = 0; i < n; ++i)
+    {
+        hugeint_Uint carry = 0;
+        for (size_t j = 0; i + j < n; ++j)
+        {
+            hugeint_Uint hi;
+            hugeint_Uint lo = mulLimb(a[i], b[j], &hi);
+            lo += carry;
+            hi += lo < carry;
+            r[i + j] += lo;
+            carry = hi + (r[i + j] < lo);
+        }
+    }
+}
+
+static inline void mulFull(hugeint_Uint *r, const hugeint_Uint *a,
+        const hugeint_Uint *b, size_t n)
+{
+    memset(r, 0, 2 * n * sizeof *r);
+    for (size_t i = 0; i < n; ++i)
+    {
+        hugeint_Uint carry = 0;
+        for (size_t j = 0; j < n; ++j)
+        {
+            hugeint_Uint hi;
+            hugeint_Uint lo = mulLimb(a[i], b[j], &hi);
+            lo += carry;
+            hi += lo < carry;
+            r[i + j] += lo;
+            carry = hi + (r[i + j] < lo);
+        }
+        r[i + n] = carry;
+    }
+}
+
+static inline int divRem(hugeint_Uint *q, hugeint_Uint *u, hugeint_Uint *v,
+        const hugeint_Uint *a, const hugeint_Uint *b, size_t n)
+{
+    size_t bn = n;
+    while (bn && !b[bn - 1]) --bn;
+    if (!bn) return 0;
+    size_t an = n;
+    while (an && !a[an - 1]) --an;
+
+    memset(q, 0, n * sizeof *q);
+    memcpy(u, a, n * sizeof *u);
+    u[n] = 0;
+    if (an < bn) return 1;
+
+    if (bn == 1)
+    {
+        hugeint_Uint rem = 0;
+        for (size_t i = an; i--;) q[i] = divLimb(rem, a[i], b[0], &rem);
+        memset(u, 0, n * sizeof *u);
+        u[0] = rem;
+        return 1;
+    }
+
+    unsigned int shift = leadingZeros(b[bn - 1]);
+    for (size_t i = bn; i--;)
+    {
+        v[i] = b[i] << shift;
+        if (shift && i) v[i] |= b[i - 1] >> (HUGEINT_ELEMENT_BITS - shift);
+    }
+    for (size_t i = an + 1; i--;)
+    {
+        hugeint_Uint w = i < an ? a[i] << shift : 0;
+        if (shift && i) w |= a[i - 1] >> (HUGEINT_ELEMENT_BITS - shift);
+        u[i] = w;
+    }
+
+    hugeint_limbsDivNorm(q, u, an, v, bn);
+
+    for (size_t i = 0; i < bn; ++i)
+    {
+        u[i] >>= shift;
+        if (shift) u[i] |= u[i + 1] << (HUGEINT_ELEMENT_BITS - shift);
+    }
+    memset(u + bn, 0, (n + 1 - bn) * sizeof *u);
+    return 1;
+}
+
+static inline int fromHugeint(hugeint_Uint *r, const hugeint *x, size_t n)
+{
+    size_t used = x->n < n ? x->n : n;
+    memcpy(r, x->e, used * sizeof *r);
+    memset(r + used, 0, (n - used) * sizeof *r);
+    return x->n <= n;
+}
+
+#define HUGEINT_FIXED_DEFINE(bits)                                           \
+void hugeint##bits##_mul(hugeint##bits *r, const hugeint##bits *a,           \
+        const hugeint##bits *b)                                              \
+{                                                                            \
+    hugeint_Uint t[HUGEINT_FIXED_LIMBS(bits)];                               \
+    mulLow(t, a->e, b->e, HUGEINT_FIXED_LIMBS(bits));                        \
+    memcpy(r->e, t, sizeof t);                                               \
+}                                                                            \
+                                                                             \
+void hugeint##bits##_mulWide(hugeint##bits *hi, hugeint##bits *lo,           \
+        const hugeint##bits *a, const hugeint##bits *b)                      \
+{                                                                            \
+    hugeint_Uint t[2 * HUGEINT_FIXED_LIMBS(bits)];                           \
+    mulFull(t, a->e, b->e, HUGEINT_FIXED_LIMBS(bits));                       \
+    memcpy(lo->e, t, sizeof lo->e);                                          \
+    memcpy(hi->e, t + HUGEINT_FIXED_LIMBS(bits), sizeof hi->e);              \
+}                                                                            \
+                                                                             \
+int hugeint##bits##_divrem(hugeint##bits *q, hugeint##bits *r,               \
+        const hugeint##bits *a, const hugeint##bits *b)                      \
+{                                                                            \
+    hugeint_Uint qt[HUGEINT_FIXED_LIMBS(bits)];                              \
+    hugeint_Uint u[HUGEINT_FIXED_LIMBS(bits) + 1];                           \
+    hugeint_Uint v[HUGEINT_FIXED_LIMBS(bits)];                               \
+    if (!divRem(qt, u, v, a->e, b->e, HUGEINT_FIXED_LIMBS(bits))) return 0;  \
+    if (q) memcpy(q->e, qt, sizeof qt);                                      \
+    if (r) memcpy(r->e, u, sizeof r->e);                                     \
+    return 1;                                                                \
+}                                                                            \
+                                                                             \
+int hugeint##bits##_fromHugeint(hugeint##bits *r, const hugeint *x)          \
+{                                                                            \
+    return fromHugeint(r->e, x, HUGEINT_FIXED_LIMBS(bits));                  \
+}                                                                            \
+                                                                             \
+hugeint *hugeint##bits##_toHugeint(const hugeint##bits *a)                   \
+{                                                                            \
+    hugeint *result = hugeint_createSized(HUGEINT_FIXED_LIMBS(bits));        \
+    memcpy(result->e, a->e, sizeof a->e);                                    \
+    hugeint_autoscale(&result);                                              \
+    return result;                                                           \
+}
+
+HUGEINT_FIXED_DEFINE(256)
+HUGEINT_FIXED_DEFINE(512)
+HUGEINT_FIXED_DEFINE(1024)
+HUGEINT_FIXED_DEFINE(2048)
+HUGEINT_FIXED_DEFINE(4096)
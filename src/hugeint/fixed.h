@@ -0,0 +1,120 @@
+#ifndef HUGEINT_FIXED_H
+#define HUGEINT_FIXED_H
+
+#include "hugeint.h"
+
+#define HUGEINT_FIXED_LIMB_BITS (CHAR_BIT * sizeof(hugeint_Uint))
+#define HUGEINT_FIXED_LIMBS(bits) ((bits) / HUGEINT_FIXED_LIMB_BITS)
+
+#define HUGEINT_FIXED_DECLARE(bits)                                           \
+typedef struct hugeint##bits                                                  \
+{                                                                             \
+    hugeint_Uint e[HUGEINT_FIXED_LIMBS(bits)];                                \
+} hugeint##bits;                                                              \
+                                                                              \
+static inline void hugeint##bits##_fromUint(hugeint##bits *r, hugeint_Uint v) \
+{                                                                             \
+    r->e[0] = v;                                                              \
+    for (size_t i = 1; i < HUGEINT_FIXED_LIMBS(bits); ++i) r->e[i] = 0;       \
+}                                                                             \
+                                                                              \
+static inline int hugeint##bits##_isZero(const hugeint##bits *a)              \
+{                                                                             \
+    hugeint_Uint v = 0;                                                       \
+    for (size_t i = 0; i < HUGEINT_FIXED_LIMBS(bits); ++i) v |= a->e[i];      \
+    return !v;                                                                \
+}                                                                             \
+                                                                              \
+static inline int hugeint##bits##_compare(const hugeint##bits *a,             \
+        const hugeint##bits *b)                                               \
+{                                                                             \
+    for (size_t i = HUGEINT_FIXED_LIMBS(bits); i--;)                          \
+    {                                                                         \
+        if (a->e[i] > b->e[i]) return 1;                                      \
+        if (a->e[i] < b->e[i]) return -1;                                     \
+    }                                                                         \
+    return 0;                                                                 \
+}                                                                             \
+                                                                              \
+static inline hugeint_Uint hugeint##bits##_add(hugeint##bits *r,              \
+        const hugeint##bits *a, const hugeint##bits *b)                       \
+{                                                                             \
+    hugeint_Uint carry = 0;                                                   \
+    for (size_t i = 0; i < HUGEINT_FIXED_LIMBS(bits); ++i)                    \
+    {                                                                         \
+        hugeint_Uint v = a->e[i] + carry;                                     \
+        carry = v < carry;                                                    \
+        v += b->e[i];                                                         \
+        carry += v < b->e[i];                                                 \
+        r->e[i] = v;                                                          \
+    }                                                                         \
+    return carry;                                                             \
+}                                                                             \
+                                                                              \
+static inline hugeint_Uint hugeint##bits##_sub(hugeint##bits *r,              \
+        const hugeint##bits *a, const hugeint##bits *b)                       \
+{                                                                             \
+    hugeint_Uint borrow = 0;                                                  \
+    for (size_t i = 0; i < HUGEINT_FIXED_LIMBS(bits); ++i)                    \
+    {                                                                         \
+        hugeint_Uint v = a->e[i] - borrow;                                    \
+        borrow = a->e[i] < borrow;                                            \
+        borrow += v < b->e[i];                                                \
+        r->e[i] = v - b->e[i];                                                \
+    }                                                                         \
+    return borrow;                                                            \
+}                                                                             \
+                                                                              \
+static inline void hugeint##bits##_shiftLeft(hugeint##bits *r,                \
+        const hugeint##bits *a, unsigned int positions)                       \
+{                                                                             \
+    size_t limbs = positions / HUGEINT_FIXED_LIMB_BITS;                       \
+    unsigned int shift = positions % HUGEINT_FIXED_LIMB_BITS;                 \
+    for (size_t i = HUGEINT_FIXED_LIMBS(bits); i--;)                          \
+    {                                                                         \
+        hugeint_Uint v = 0;                                                   \
+        if (i >= limbs) v = a->e[i - limbs] << shift;                         \
+        if (shift && i > limbs)                                               \
+        {                                                                     \
+            v |= a->e[i - limbs - 1] >> (HUGEINT_FIXED_LIMB_BITS - shift);    \
+        }                                                                     \
+        r->e[i] = v;                                                          \
+    }                                                                         \
+}                                                                             \
+                                                                              \
+static inline void hugeint##bits##_shiftRight(hugeint##bits *r,               \
+        const hugeint##bits *a, unsigned int positions)                       \
+{                                                                             \
+    size_t limbs = positions / HUGEINT_FIXED_LIMB_BITS;                       \
+    unsigned int shift = positions % HUGEINT_FIXED_LIMB_BITS;                 \
+    for (size_t i = 0; i < HUGEINT_FIXED_LIMBS(bits); ++i)                    \
+    {                                                                         \
+        hugeint_Uint v = 0;                                                   \
+        if (i + limbs < HUGEINT_FIXED_LIMBS(bits))                            \
+        {                                                                     \
+            v = a->e[i + limbs] >> shift;                                     \
+        }                                                                     \
+        if (shift && i + limbs + 1 < HUGEINT_FIXED_LIMBS(bits))               \
+        {                                                                     \
+            v |= a->e[i + limbs + 1] << (HUGEINT_FIXED_LIMB_BITS - shift);    \
+        }                                                                     \
+        r->e[i] = v;                                                          \
+    }                                                                         \
+}                                                                             \
+                                                                              \
+void hugeint##bits##_mul(hugeint##bits *r, const hugeint##bits *a,            \
+        const hugeint##bits *b);                                              \
+void hugeint##bits##_mulWide(hugeint##bits *hi, hugeint##bits *lo,            \
+        const hugeint##bits *a, const hugeint##bits *b);                      \
+int hugeint##bits##_divrem(hugeint##bits *q, hugeint##bits *r,                \
+        const hugeint##bits *a, const hugeint##bits *b);                      \
+int hugeint##bits##_fromHugeint(hugeint##bits *r, const hugeint *x);          \
+hugeint *hugeint##bits##_toHugeint(const hugeint##bits *a);
+
+HUGEINT_FIXED_DECLARE(256)
+HUGEINT_FIXED_DECLARE(512)
+HUGEINT_FIXED_DECLARE(1024)
+HUGEINT_FIXED_DECLARE(2048)
+HUGEINT_FIXED_DECLARE(4096)
+
+#endif
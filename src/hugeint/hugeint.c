@@ -1,208 +1,251 @@
-#include <limits.h>
-#include <stdlib.h>
 #include <string.h>
 
-#include "hugeint.h"
+#include "internal.h"
 
-#define HUGEINT_ELEMENT_BITS (CHAR_BIT * sizeof(hugeint_Uint))
-#define HUGEINT_INITIAL_ELEMENTS (256 / HUGEINT_ELEMENT_BITS)
+#define HUGEINT_HASH_LANES 4
 
-struct hugeint
-{
-    size_t s;
-    size_t n;
-    hugeint_Uint e[];
-};
-
-static void *xmalloc(size_t size)
-{
-    void *m = malloc(size);
-    if (!m) exit(1);
-    return m;
-}
+static atomic_uint growthPercent = 200;
 
-static void *xrealloc(void *m, size_t size)
+void hugeint_setGrowthPercent(unsigned int percent)
 {
-    void *m2 = realloc(m, size);
-    if (!m2) exit(1);
-    return m2;
+    atomic_store_explicit(&growthPercent, percent < 100 ? 100 : percent,
+            memory_order_relaxed);
 }
 
-static size_t copyNum(char **out, const char *str)
-{
-    const char *p = str;
-    const char *start;
-    size_t length = 0;
-    while (*p && (*p == ' ' || *p == '\t' || *p == '0')) ++p;
-    if (*p < '0' || *p > '9') return 0;
-
-    start = p;
-    while (*p >= '0' && *p <= '9')
-    {
-        ++p;
-        ++length;
-    }
-
-    *out = xmalloc(length + 1);
-    (*out)[length] = 0;
-    memcpy(*out, start, length);
-    return length;
-}
-
-static hugeint *hugeint_scale(hugeint *self, size_t newSize)
+hugeint *hugeint_scale(hugeint *self, size_t newSize)
 {
     if (newSize == self->n) return self;
     if (newSize > self->s)
     {
-        size_t s = self->s;
-        while (newSize > s) s *= 2;
-        self = xrealloc(self,
-                sizeof(hugeint) + s * sizeof(hugeint_Uint));
+        unsigned int percent = atomic_load_explicit(&growthPercent,
+                memory_order_relaxed);
+        size_t s = self->s + self->s * (percent - 100) / 100;
+        if (s < newSize) s = newSize;
+        self = hugeint_realloc(self, s);
         self->s = s;
     }
     if (newSize > self->n)
     {
         memset(&(self->e[self->n]), 0,
-                (self->s - self->n) * sizeof(hugeint_Uint));
-    }
-    else if (newSize < self->n)
-    {
-        memset(&(self->e[newSize]), 0,
-                (self->n - newSize) * sizeof(hugeint_Uint));
+                (newSize - self->n) * sizeof(hugeint_Uint));
     }
     self->n = newSize;
     return self;
 }
 
-static void hugeint_autoscale(hugeint **self)
+void hugeint_autoscale(hugeint **self)
 {
-    (*self)->n = (*self)->s;
     while ((*self)->n > 1 && !(*self)->e[(*self)->n-1]) --(*self)->n;
 }
 
-static hugeint *hugeint_createSized(size_t size)
+hugeint *hugeint_createSized(size_t size)
 {
     size_t s = size;
     if (s < HUGEINT_INITIAL_ELEMENTS) s = HUGEINT_INITIAL_ELEMENTS;
-    hugeint *self = xmalloc(sizeof(hugeint) + s * sizeof(hugeint_Uint));
-    memset(self, 0, sizeof(hugeint) + s * sizeof(hugeint_Uint));
+    hugeint *self = hugeint_alloc(s);
+    memset(self->e, 0, s * sizeof(hugeint_Uint));
     self->s = s;
     self->n = size;
     return self;
 }
 
-hugeint *hugeint_create(void)
+hugeint_Uint hugeint_limbsAdd(hugeint_Uint *r, const hugeint_Uint *a,
+        size_t an, const hugeint_Uint *b, size_t bn)
 {
-    return hugeint_createSized(1);
+    hugeint_Uint carry = 0;
+    size_t i;
+    for (i = 0; i < bn; ++i)
+    {
+        hugeint_Uint v = a[i] + b[i];
+        hugeint_Uint nextCarry = v < b[i];
+        r[i] = v + carry;
+        carry = nextCarry | (r[i] < carry);
+    }
+    for (; i < an; ++i)
+    {
+        r[i] = a[i] + carry;
+        carry = r[i] < carry;
+    }
+    return carry;
 }
 
-hugeint *hugeint_clone(const hugeint *self)
+hugeint_Uint hugeint_limbsSub(hugeint_Uint *r, const hugeint_Uint *a,
+        size_t an, const hugeint_Uint *b, size_t bn)
 {
-    hugeint *clone = xmalloc(sizeof(hugeint) + self->s * sizeof(hugeint_Uint));
-    memcpy(clone, self, sizeof(hugeint) + self->s * sizeof(hugeint_Uint));
-    return clone;
+    hugeint_Uint borrow = 0;
+    size_t i;
+    for (i = 0; i < bn; ++i)
+    {
+        hugeint_Uint d = a[i] - b[i];
+        hugeint_Uint nextBorrow = a[i] < b[i];
+        r[i] = d - borrow;
+        borrow = nextBorrow | (d < borrow);
+    }
+    for (; i < an; ++i)
+    {
+        r[i] = a[i] - borrow;
+        borrow = a[i] < borrow;
+    }
+    return borrow;
 }
 
-hugeint *hugeint_fromUint(hugeint_Uint val)
+hugeint_Uint hugeint_limbsMulUint(hugeint_Uint *r, const hugeint_Uint *a,
+        size_t n, hugeint_Uint b)
 {
-    hugeint *self = hugeint_create();
-    self->e[0] = val;
-    return self;
+    hugeint_Uint carry = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        hugeint_Uint hi;
+        hugeint_Uint lo = mulLimb(a[i], b, &hi);
+        lo += carry;
+        carry = hi + (lo < carry);
+        r[i] = lo;
+    }
+    return carry;
 }
 
-hugeint *hugeint_parse(const char *str)
+hugeint_Uint hugeint_limbsAddMulUint(hugeint_Uint *r, const hugeint_Uint *a,
+        size_t n, hugeint_Uint b)
 {
-    char *buf;
-    hugeint *result = hugeint_create();
-    size_t bcdsize = copyNum(&buf, str);
-    if (!bcdsize) return result;
-
-    size_t scanstart = 0;
-    size_t n = 0;
-    size_t i;
-    hugeint_Uint mask = 1;
-
-    for (i = 0; i < bcdsize; ++i) buf[i] -= '0';
-
-    while (scanstart < bcdsize)
+    hugeint_Uint carry = 0;
+    for (size_t i = 0; i < n; ++i)
     {
-        if (buf[bcdsize - 1] & 1) result->e[n] |= mask;
-        mask <<= 1;
-        if (!mask)
-        {
-            mask = 1;
-            if (++n == result->n) result = hugeint_scale(result, result->n + 1);
-        }
-        for (i = bcdsize - 1; i > scanstart; --i)
-        {
-            buf[i] >>= 1;
-            if (buf[i-1] & 1) buf[i] |= 8;
-        }
-        buf[scanstart] >>= 1;
-        while (scanstart < bcdsize && !buf[scanstart]) ++scanstart;
-        for (i = scanstart; i < bcdsize; ++i)
-        {
-            if (buf[i] > 7) buf[i] -= 3;
-        }
+        hugeint_Uint hi;
+        hugeint_Uint lo = mulLimb(a[i], b, &hi);
+        lo += carry;
+        carry = hi + (lo < carry);
+        r[i] += lo;
+        carry += r[i] < lo;
     }
-
-    free(buf);
-    return result;
+    return carry;
 }
 
-static unsigned char hexNibble(const char *str)
+hugeint_Uint hugeint_limbsSubMulUint(hugeint_Uint *r, const hugeint_Uint *a,
+        size_t n, hugeint_Uint b)
 {
-    unsigned char hex = *str;
-    if (hex >= 'a' && hex <='f')
-    {
-        hex -= ('a' - 10);
-    }
-    else if (hex >= 'A' && hex <= 'F')
+    hugeint_Uint borrow = 0;
+    for (size_t i = 0; i < n; ++i)
     {
-        hex -= ('A' - 10);
+        hugeint_Uint hi;
+        hugeint_Uint lo = mulLimb(a[i], b, &hi);
+        lo += borrow;
+        borrow = hi + (lo < borrow);
+        hugeint_Uint v = r[i];
+        r[i] = v - lo;
+        borrow += v < lo;
     }
-    else if (hex >= '0' && hex <= '9')
+    return borrow;
+}
+
+hugeint_Uint hugeint_limbsDivUint(hugeint_Uint *q, const hugeint_Uint *a,
+        size_t n, const hugeint_UintDivisor *divisor)
+{
+    hugeint_Uint d = divisor->d << divisor->shift;
+    hugeint_Uint r = 0;
+    if (!n) return 0;
+    if (!divisor->shift)
     {
-        hex -= '0';
+        while (n--)
+        {
+            hugeint_Uint qn = divLimbPreinv(r, a[n], d, divisor->v, &r);
+            if (q) q[n] = qn;
+        }
+        return r;
     }
-    else
+
+    unsigned int back = HUGEINT_ELEMENT_BITS - divisor->shift;
+    hugeint_Uint n1 = a[n-1];
+    r = n1 >> back;
+    while (--n)
     {
-        hex = 0;
+        hugeint_Uint n0 = a[n-1];
+        hugeint_Uint qn = divLimbPreinv(r,
+                (n1 << divisor->shift) | (n0 >> back), d, divisor->v, &r);
+        if (q) q[n] = qn;
+        n1 = n0;
     }
-    return hex;
+    hugeint_Uint q0 = divLimbPreinv(r, n1 << divisor->shift, d, divisor->v,
+            &r);
+    if (q) q[0] = q0;
+    return r >> divisor->shift;
 }
 
-hugeint *hugeint_parseHex(const char *str)
+void hugeint_limbsDivNorm(hugeint_Uint *q, hugeint_Uint *u, size_t un,
+        const hugeint_Uint *v, size_t vn)
 {
-    size_t len = strlen(str);
-    size_t bits = len * 4;
-    size_t n = HUGEINT_ELEMENT_BITS / bits;
-    size_t leading = HUGEINT_ELEMENT_BITS % bits;
-    size_t i = n;
-    if (leading) ++n;
-    hugeint *result = hugeint_createSized(n);
-    if (leading)
+    hugeint_Uint d = v[vn - 1];
+    hugeint_Uint d2 = v[vn - 2];
+    for (size_t j = un - vn + 1; j--;)
     {
-        hugeint_Uint shift = leading;
-        while (shift)
+        hugeint_Uint u2 = u[j + vn];
+        hugeint_Uint u1 = u[j + vn - 1];
+        hugeint_Uint u0 = u[j + vn - 2];
+        hugeint_Uint qhat;
+        hugeint_Uint rhat;
+        int rhatOverflow = 0;
+        if (u2 >= d)
         {
-            shift -= 4;
-            unsigned char nibble = hexNibble(str++);
-            result->e[i] |= ((hugeint_Uint)nibble << shift);
+            qhat = ~(hugeint_Uint)0U;
+            rhat = u1 + d;
+            rhatOverflow = rhat < u1;
         }
-    }
-    while (i)
-    {
-        --i;
-        hugeint_Uint shift = HUGEINT_ELEMENT_BITS;
-        while (shift)
+        else qhat = divLimb(u2, u1, d, &rhat);
+
+        while (!rhatOverflow)
         {
-            shift -= 4;
-            unsigned char nibble = hexNibble(str++);
-            result->e[i] |= ((hugeint_Uint)nibble << shift);
+            hugeint_Uint ph;
+            hugeint_Uint pl = mulLimb(qhat, d2, &ph);
+            if (ph < rhat || (ph == rhat && pl <= u0)) break;
+            --qhat;
+            rhat += d;
+            rhatOverflow = rhat < d;
         }
+
+        hugeint_Uint borrow = hugeint_limbsSubMulUint(&(u[j]), v, vn, qhat);
+        hugeint_Uint top = u[j + vn];
+        u[j + vn] = top - borrow;
+        if (top < borrow)
+        {
+            --qhat;
+            u[j + vn] += hugeint_limbsAdd(&(u[j]), &(u[j]), vn, v, vn);
+        }
+        q[j] = qhat;
     }
-    return result;
+}
+
+hugeint *hugeint_create(void)
+{
+    return hugeint_createSized(1);
+}
+
+hugeint *hugeint_clone(const hugeint *self)
+{
+    hugeint *clone = hugeint_alloc(self->n);
+    clone->s = self->n;
+    clone->n = self->n;
+    memcpy(clone->e, self->e, self->n * sizeof(hugeint_Uint));
+    return clone;
+}
+
+void hugeint_reserve(hugeint **self, size_t size)
+{
+    if (size <= (*self)->s) return;
+    *self = hugeint_realloc(*self, size);
+    (*self)->s = size;
+}
+
+void hugeint_shrinkToFit(hugeint **self)
+{
+    if ((*self)->s == (*self)->n) return;
+    *self = hugeint_realloc(*self, (*self)->n);
+    (*self)->s = (*self)->n;
+}
+
+hugeint *hugeint_fromUint(hugeint_Uint val)
+{
+    hugeint *self = hugeint_create();
+    self->e[0] = val;
+    return self;
 }
 
 hugeint *hugeint_add(const hugeint *a, const hugeint *b)
@@ -214,103 +257,90 @@ hugeint *hugeint_add(const hugeint *a, const hugeint *b)
         b = tmp;
     }
 
-    hugeint *result = hugeint_clone(a);
-    hugeint_addToSelf(&result, b);
+    hugeint *result = hugeint_createSized(a->n + 1);
+    result->e[a->n] = hugeint_limbsAdd(result->e, a->e, a->n, b->e, b->n);
+    hugeint_autoscale(&result);
     return result;
 }
 
 hugeint *hugeint_sub(const hugeint *minuend, const hugeint *subtrahend)
 {
-    hugeint *result = hugeint_clone(minuend);
-    hugeint_subFromSelf(&result, subtrahend);
+    if (subtrahend->n > minuend->n) return 0;
+    hugeint *result = hugeint_createSized(minuend->n);
+    if (hugeint_limbsSub(result->e, minuend->e, minuend->n,
+                subtrahend->e, subtrahend->n))
+    {
+        hugeint_free(result);
+        return 0;
+    }
+    hugeint_autoscale(&result);
     return result;
 }
 
-static hugeint *multUint(hugeint_Uint a, hugeint_Uint b)
+static hugeint *multBasecase(const hugeint *a, const hugeint *b)
 {
-    if (!a || !b) return hugeint_create();
-    if (a < b)
+    hugeint *result = hugeint_createSized(a->n + b->n);
+    for (size_t i = 0; i < b->n; ++i)
     {
-        hugeint_Uint tmp = a;
-        a = b;
-        b = tmp;
+        result->e[i + a->n] = hugeint_limbsAddMulUint(&(result->e[i]),
+                a->e, a->n, b->e[i]);
     }
-    hugeint_Uint halfMask = ((hugeint_Uint)1U << (HUGEINT_ELEMENT_BITS / 2)) - 1;
-    hugeint_Uint maskA = halfMask;
-    hugeint_Uint maskB = halfMask;
-    hugeint_Uint direct = 0;
-    while (maskB)
-    {
-        if (a > maskA && b > maskB) break;
-        if (a <= maskA && b <= maskB)
-        {
-            direct = 1;
-            break;
-        }
-        maskA = (maskA << 1) | 1;
-        maskB >>= 1;
-    }
-    if (direct)
-    {
-        return hugeint_fromUint(a * b);
-    }
-    hugeint_Uint ah = a >> (HUGEINT_ELEMENT_BITS / 2);
-    hugeint_Uint al = a & halfMask;
-    hugeint_Uint bh = b >> (HUGEINT_ELEMENT_BITS / 2);
-    hugeint_Uint bl = b & halfMask;
+    hugeint_autoscale(&result);
+    hugeint_progressAdd(a->n * b->n);
+    return result;
+}
+
+static hugeint *multRec(const hugeint *a, const hugeint *b);
+
+static hugeint *multUnbalanced(const hugeint *a, const hugeint *b)
+{
+    size_t chunks = a->n / b->n;
+    size_t chunkSize = (a->n + chunks - 1) / chunks;
+    hugeint *result = hugeint_createSized(a->n + b->n);
+    hugeint *chunk = hugeint_createSized(chunkSize);
 
-    hugeint *p1 = multUint(ah, bh);
-    hugeint *p2 = multUint(al, bl);
-    hugeint_Uint p3f1u = ah + al;
-    hugeint_Uint p3f2u = bh + bl;
-    hugeint *p3;
-    if (p3f1u < ah || p3f2u < bh)
+    for (size_t off = 0; off < a->n; off += chunkSize)
     {
-        hugeint *p3f1;
-        hugeint *p3f2;
-        if (p3f1u < ah)
-        {
-            p3f1 = hugeint_createSized(2);
-            p3f1->e[0] = p3f1u;
-            p3f1->e[1] = 1;
-        }
-        else p3f1 = hugeint_fromUint(p3f1u);
-        if (p3f2u < bh)
+        size_t len = a->n - off;
+        if (len > chunkSize) len = chunkSize;
+        memcpy(chunk->e, &(a->e[off]), len * sizeof(hugeint_Uint));
+        chunk->n = len;
+        hugeint_autoscale(&chunk);
+        if (hugeint_isZero(chunk)) continue;
+
+        hugeint *p = multRec(chunk, b);
+        hugeint_Uint *e = &(result->e[off]);
+        hugeint_Uint carry = hugeint_limbsAdd(e, e, p->n, p->e, p->n);
+        for (size_t i = off + p->n; carry; ++i)
         {
-            p3f2 = hugeint_createSized(2);
-            p3f2->e[0] = p3f2u;
-            p3f2->e[1] = 1;
+            carry = !++result->e[i];
         }
-        else p3f2 = hugeint_fromUint(p3f2u);
-        p3 = hugeint_mult(p3f1, p3f2);
-        free(p3f1);
-        free(p3f2);
+        hugeint_free(p);
+        if (hugeint_progressAborted()) break;
     }
-    else
+
+    hugeint_free(chunk);
+    if (hugeint_progressAborted())
     {
-        p3 = multUint(p3f1u, p3f2u);
+        hugeint_free(result);
+        return hugeint_create();
     }
-    hugeint_subFromSelf(&p3, p2);
-    hugeint_subFromSelf(&p3, p1);
-    hugeint_shiftLeft(&p3, HUGEINT_ELEMENT_BITS - (HUGEINT_ELEMENT_BITS / 2));
-    hugeint_shiftLeft(&p1, HUGEINT_ELEMENT_BITS);
-    hugeint_addToSelf(&p3, p1);
-    hugeint_addToSelf(&p3, p2);
-    free(p2);
-    free(p1);
-    return p3;
+    hugeint_autoscale(&result);
+    return result;
 }
 
-hugeint *hugeint_mult(const hugeint *a, const hugeint *b)
+static hugeint *multRec(const hugeint *a, const hugeint *b)
 {
     if (hugeint_isZero(a) || hugeint_isZero(b)) return hugeint_create();
+    if (hugeint_progressAborted()) return hugeint_create();
     if (b->n > a->n)
     {
         const hugeint *tmp = a;
         a = b;
         b = tmp;
     }
-    if (a->n == 1) return multUint(a->e[0], b->e[0]);
+    if (b->n <= HUGEINT_MULT_THRESHOLD) return multBasecase(a, b);
+    if (a->n >= 2 * b->n) return multUnbalanced(a, b);
 
     size_t nh = a->n / 2;
     size_t nl = a->n - nh;
@@ -339,24 +369,126 @@ hugeint *hugeint_mult(const hugeint *a, const hugeint *b)
     hugeint_autoscale(&bh);
     hugeint_autoscale(&bl);
 
-    hugeint *p1 = hugeint_mult(ah, bh);
-    hugeint *p2 = hugeint_mult(al, bl);
+    hugeint *p1 = multRec(ah, bh);
+    hugeint *p2 = multRec(al, bl);
     hugeint_addToSelf(&ah, al);
     hugeint_addToSelf(&bh, bl);
-    free(al);
-    free(bl);
-    hugeint *p3 = hugeint_mult(ah, bh);
-    free(ah);
-    free(bh);
+    hugeint_free(al);
+    hugeint_free(bl);
+    hugeint *p3 = multRec(ah, bh);
+    hugeint_free(ah);
+    hugeint_free(bh);
+    if (hugeint_progressAborted())
+    {
+        hugeint_free(p3);
+        hugeint_free(p2);
+        hugeint_free(p1);
+        return hugeint_create();
+    }
     hugeint_subFromSelf(&p3, p2);
     hugeint_subFromSelf(&p3, p1);
-    hugeint_shiftLeft(&p3, nl * HUGEINT_ELEMENT_BITS);
-    hugeint_shiftLeft(&p1, 2 * nl * HUGEINT_ELEMENT_BITS);
-    hugeint_addToSelf(&p3, p1);
-    hugeint_addToSelf(&p3, p2);
-    free(p2);
-    free(p1);
-    return p3;
+
+    hugeint *result = hugeint_createSized(a->n + b->n);
+    memcpy(result->e, p2->e, p2->n * sizeof(hugeint_Uint));
+    if (!hugeint_isZero(p1))
+    {
+        memcpy(&(result->e[2 * nl]), p1->e, p1->n * sizeof(hugeint_Uint));
+    }
+    hugeint_autoscale(&result);
+    hugeint_addShiftedToSelf(&result, p3, nl);
+    hugeint_free(p3);
+    hugeint_free(p2);
+    hugeint_free(p1);
+    return result;
+}
+
+hugeint *hugeint_mult(const hugeint *a, const hugeint *b)
+{
+    hugeint_progressEnter(hugeint_multCost(a->n, b->n));
+    hugeint *result = multRec(a, b);
+    if (hugeint_progressLeave())
+    {
+        hugeint_free(result);
+        return 0;
+    }
+    return result;
+}
+
+size_t hugeint_multCost(size_t an, size_t bn)
+{
+    if (bn > an)
+    {
+        size_t tmp = an;
+        an = bn;
+        bn = tmp;
+    }
+    if (bn <= HUGEINT_MULT_THRESHOLD) return an * bn;
+    if (an >= 2 * bn)
+    {
+        size_t chunks = an / bn;
+        return chunks * hugeint_multCost((an + chunks - 1) / chunks, bn);
+    }
+    return 3 * hugeint_multCost(an - an / 2, bn - bn / 2);
+}
+
+size_t hugeint_squaringCost(size_t n)
+{
+    size_t cost = 0;
+    for (n /= 2; n; n /= 2) cost += hugeint_multCost(n, n);
+    return cost;
+}
+
+static hugeint *divRec(const hugeint *dividend, const hugeint *divisor,
+        hugeint **remainder)
+{
+    if (hugeint_compare(dividend, divisor) < 0)
+    {
+        *remainder = hugeint_clone(dividend);
+        return hugeint_create();
+    }
+
+    if (divisor->n == 1)
+    {
+        hugeint *result = hugeint_clone(dividend);
+        hugeint_Uint r = hugeint_divUintToSelf(&result, divisor->e[0]);
+        *remainder = hugeint_fromUint(r);
+        return result;
+    }
+
+    unsigned int shift = leadingZeros(divisor->e[divisor->n - 1]);
+    hugeint *v = hugeint_clone(divisor);
+    hugeint *u = hugeint_createSized(dividend->n + 1);
+    memcpy(u->e, dividend->e, dividend->n * sizeof(hugeint_Uint));
+    u->n = dividend->n;
+    hugeint_shiftLeft(&v, shift);
+    hugeint_shiftLeft(&u, shift);
+
+    size_t qn = dividend->n - divisor->n + 1;
+    hugeint *result = hugeint_createSized(qn);
+    for (size_t hi = qn; hi;)
+    {
+        size_t lo = hi > HUGEINT_PROGRESS_LIMBS
+                ? hi - HUGEINT_PROGRESS_LIMBS : 0;
+        hugeint_limbsDivNorm(&(result->e[lo]), &(u->e[lo]),
+                hi - lo + divisor->n - 1, v->e, divisor->n);
+        if (hugeint_progressAdd((hi - lo) * divisor->n)) break;
+        hi = lo;
+    }
+    hugeint_free(v);
+    if (hugeint_progressAborted())
+    {
+        hugeint_free(u);
+        hugeint_free(result);
+        *remainder = hugeint_create();
+        return hugeint_create();
+    }
+    hugeint_autoscale(&result);
+
+    u->n = divisor->n;
+    hugeint_autoscale(&u);
+    hugeint_shiftRight(&u, shift);
+    *remainder = u;
+    return result;
 }
 
 hugeint *hugeint_div(const hugeint *dividend, const hugeint *divisor,
@@ -364,65 +496,201 @@ hugeint *hugeint_div(const hugeint *dividend, const hugeint *divisor,
 {
     if (hugeint_isZero(divisor)) return 0;
 
-    hugeint *scaledDivisor = hugeint_clone(divisor);
-    hugeint *remain = hugeint_clone(dividend);
-    hugeint *result = hugeint_create();
-    hugeint *multiple = hugeint_fromUint(1);
+    hugeint *r;
+    hugeint_progressEnter(dividend->n >= divisor->n
+            ? (dividend->n - divisor->n + 1) * divisor->n : 0);
+    hugeint *result = divRec(dividend, divisor, &r);
+    if (hugeint_progressLeave())
+    {
+        hugeint_free(result);
+        hugeint_free(r);
+        return 0;
+    }
+    if (remainder) *remainder = r;
+    else hugeint_free(r);
+    return result;
+}
+
+hugeint *hugeint_divExact(const hugeint *dividend, const hugeint *divisor)
+{
+    if (hugeint_isZero(divisor)) return 0;
+    if (hugeint_isZero(dividend) || dividend->n < divisor->n)
+    {
+        return hugeint_create();
+    }
 
-    while (hugeint_compare(scaledDivisor, dividend) < 0)
+    size_t shift = hugeint_scanLowestSet(divisor);
+    if (shift)
     {
-        hugeint_shiftLeft(&scaledDivisor, 1);
-        hugeint_shiftLeft(&multiple, 1);
+        hugeint *a = hugeint_clone(dividend);
+        hugeint *d = hugeint_clone(divisor);
+        hugeint_shiftRight(&a, shift);
+        hugeint_shiftRight(&d, shift);
+        hugeint *result = hugeint_divExact(a, d);
+        hugeint_free(a);
+        hugeint_free(d);
+        return result;
     }
 
-    do
+    size_t qn = dividend->n - divisor->n + 1;
+    hugeint *result = hugeint_createSized(qn);
+    memcpy(result->e, dividend->e, qn * sizeof(hugeint_Uint));
+    hugeint_Uint *r = result->e;
+    hugeint_Uint inv = limbInverse(divisor->e[0]);
+
+    for (size_t i = 0; i < qn; ++i)
     {
-        if (hugeint_compare(remain, scaledDivisor) >= 0)
+        hugeint_Uint q = r[i] * inv;
+        size_t k = qn - i;
+        if (k > divisor->n) k = divisor->n;
+        hugeint_Uint borrow = hugeint_limbsSubMulUint(&(r[i]), divisor->e, k, q);
+        r[i] = q;
+        for (size_t j = i + k; borrow && j < qn; ++j)
         {
-            hugeint_subFromSelf(&remain, scaledDivisor);
-            hugeint_addToSelf(&result, multiple);
+            hugeint_Uint v = r[j];
+            r[j] = v - borrow;
+            borrow = v < borrow;
         }
-        hugeint_shiftRight(&scaledDivisor, 1);
-        hugeint_shiftRight(&multiple, 1);
-    } while (!hugeint_isZero(multiple));
-
-    if (remainder) *remainder = remain;
-    else free(remain);
-    free(multiple);
-    free(scaledDivisor);
+    }
+
+    hugeint_autoscale(&result);
     return result;
 }
 
-int hugeint_isZero(const hugeint *self)
+hugeint *hugeint_sumArray(size_t n, hugeint *const *xs)
 {
-    for (size_t i = 0; i < self->n; ++i)
+    size_t size = 1;
+    for (size_t j = 0; j < n; ++j)
     {
-        if (self->e[i]) return 0;
+        if (xs[j]->n > size) size = xs[j]->n;
     }
-    return 1;
-}
+    hugeint *result = hugeint_createSized(size + 1);
+    hugeint_Uint *carries = xmalloc(size * sizeof *carries);
+    memset(carries, 0, size * sizeof *carries);
 
-int hugeint_compare(const hugeint *self, const hugeint *other)
-{
-    size_t n;
-    if (self->n > other->n)
+    for (size_t j = 0; j < n; ++j)
     {
-        for (size_t i = other->n; i < self->n; ++i)
+        const hugeint *x = xs[j];
+        for (size_t i = 0; i < x->n; ++i)
         {
-            if (self->e[i]) return 1;
+            result->e[i] += x->e[i];
+            carries[i] += result->e[i] < x->e[i];
         }
-        n = other->n;
     }
-    else if (self->n < other->n)
+
+    hugeint_Uint carry = 0;
+    for (size_t i = 0; i < size; ++i)
     {
-        for (size_t i = self->n; i < other->n; ++i)
-        {
-            if (other->e[i]) return -1;
-        }
-        n = self->n;
+        result->e[i] += carry;
+        carry = carries[i] + (result->e[i] < carry);
+    }
+    result->e[size] = carry;
+    free(carries);
+    hugeint_autoscale(&result);
+    return result;
+}
+
+struct factor
+{
+    hugeint *value;
+    int owned;
+};
+
+static void siftDown(struct factor *heap, size_t n, size_t i)
+{
+    for (;;)
+    {
+        size_t min = i;
+        size_t l = 2 * i + 1;
+        size_t r = l + 1;
+        if (l < n && heap[l].value->n < heap[min].value->n) min = l;
+        if (r < n && heap[r].value->n < heap[min].value->n) min = r;
+        if (min == i) return;
+        struct factor tmp = heap[i];
+        heap[i] = heap[min];
+        heap[min] = tmp;
+        i = min;
+    }
+}
+
+static struct factor popFactor(struct factor *heap, size_t *n)
+{
+    struct factor top = heap[0];
+    heap[0] = heap[--*n];
+    siftDown(heap, *n, 0);
+    return top;
+}
+
+static void pushFactor(struct factor *heap, size_t *n, struct factor f)
+{
+    size_t i = (*n)++;
+    heap[i] = f;
+    while (i && heap[(i - 1) / 2].value->n > heap[i].value->n)
+    {
+        struct factor tmp = heap[i];
+        heap[i] = heap[(i - 1) / 2];
+        heap[(i - 1) / 2] = tmp;
+        i = (i - 1) / 2;
     }
-    else n = self->n;
+}
+
+hugeint *hugeint_productArray(size_t n, hugeint *const *xs)
+{
+    if (!n) return hugeint_fromUint(1);
+    for (size_t j = 0; j < n; ++j)
+    {
+        if (hugeint_isZero(xs[j])) return hugeint_create();
+    }
+    if (n == 1) return hugeint_clone(xs[0]);
+
+    struct factor *heap = xmalloc(n * sizeof *heap);
+    size_t limbs = 0;
+    for (size_t j = 0; j < n; ++j)
+    {
+        heap[j].value = xs[j];
+        heap[j].owned = 0;
+        limbs += xs[j]->n;
+    }
+    size_t estimate = 0;
+    for (size_t width = 1; width < n; width *= 2)
+    {
+        size_t half = limbs / width / 2;
+        estimate += width * hugeint_multCost(half, half);
+    }
+    hugeint_progressEnter(estimate);
+    for (size_t j = n / 2; j > 0; --j) siftDown(heap, n, j - 1);
+
+    while (n > 1)
+    {
+        struct factor a = popFactor(heap, &n);
+        struct factor b = popFactor(heap, &n);
+        struct factor p = { multRec(a.value, b.value), 1 };
+        if (a.owned) hugeint_free(a.value);
+        if (b.owned) hugeint_free(b.value);
+        pushFactor(heap, &n, p);
+    }
+
+    hugeint *result = heap[0].value;
+    free(heap);
+    if (hugeint_progressLeave())
+    {
+        hugeint_free(result);
+        return 0;
+    }
+    return result;
+}
+
+int hugeint_isZero(const hugeint *self)
+{
+    return self->n == 1 && !self->e[0];
+}
+
+int hugeint_compare(const hugeint *self, const hugeint *other)
+{
+    if (self->n > other->n) return 1;
+    if (self->n < other->n) return -1;
 
+    size_t n = self->n;
     while (n > 0)
     {
         --n;
@@ -435,15 +703,63 @@ int hugeint_compare(const hugeint *self, const hugeint *other)
 
 int hugeint_compareUint(const hugeint *self, hugeint_Uint other)
 {
-    for (size_t i = self->n - 1; i > 0; --i)
-    {
-        if (self->e[i]) return 1;
-    }
+    if (self->n > 1) return 1;
     if (self->e[0] > other) return 1;
     if (self->e[0] < other) return -1;
     return 0;
 }
 
+int hugeint_equal(const hugeint *self, const hugeint *other)
+{
+    if (self->n != other->n) return 0;
+    return !memcmp(self->e, other->e, self->n * sizeof *self->e);
+}
+
+static hugeint_Uint hashRound(hugeint_Uint lane, hugeint_Uint limb)
+{
+    lane += limb * 0xc2b2ae3d27d4eb4fU;
+    lane = (lane << 31) | (lane >> (HUGEINT_ELEMENT_BITS - 31));
+    return lane * 0x9e3779b185ebca87U;
+}
+
+static hugeint_Uint hashMix(hugeint_Uint h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdU;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53U;
+    h ^= h >> 33;
+    return h;
+}
+
+size_t hugeint_hash(const hugeint *self, size_t seed)
+{
+    hugeint_Uint lanes[HUGEINT_HASH_LANES];
+    for (unsigned int j = 0; j < HUGEINT_HASH_LANES; ++j)
+    {
+        lanes[j] = seed + (j + 1) * 0x9e3779b97f4a7c15U;
+    }
+    size_t i = 0;
+    for (; i + HUGEINT_HASH_LANES <= self->n; i += HUGEINT_HASH_LANES)
+    {
+        for (unsigned int j = 0; j < HUGEINT_HASH_LANES; ++j)
+        {
+            lanes[j] = hashRound(lanes[j], self->e[i + j]);
+        }
+    }
+    for (unsigned int j = 0; i + j < self->n; ++j)
+    {
+        lanes[j] = hashRound(lanes[j], self->e[i + j]);
+    }
+
+    hugeint_Uint h = hashMix(seed ^ self->n);
+    for (unsigned int j = 0; j < HUGEINT_HASH_LANES; ++j)
+    {
+        h = hashMix(h ^ lanes[j]) * 0x9e3779b185ebca87U;
+    }
+    return (size_t)hashMix(h);
+}
+
 void hugeint_increment(hugeint **self)
 {
     int carry = 0;
@@ -519,29 +835,32 @@ void hugeint_addUintToSelf(hugeint **self, hugeint_Uint other)
 
 void hugeint_subFromSelf(hugeint **self, const hugeint *other)
 {
-    if (hugeint_isZero(other)) return;
-    int comp = hugeint_compare(*self, other);
-    if (comp < 0)
+    if (other->n > (*self)->n)
     {
-        free(*self);
+        hugeint_free(*self);
         *self = 0;
         return;
     }
-    if (comp == 0)
+
+    unsigned int borrow = 0;
+    size_t i;
+    for (i = 0; i < other->n; ++i)
     {
-        *self = hugeint_scale(*self, 1);
-        (*self)->e[0] = 0;
-        return;
+        hugeint_Uint v = (*self)->e[i];
+        hugeint_Uint d = v - other->e[i];
+        unsigned int nextBorrow = v < other->e[i];
+        (*self)->e[i] = d - borrow;
+        borrow = nextBorrow | (d < borrow);
     }
-
-    unsigned int carry = 1;
-    for (size_t i = 0; i < (*self)->n; ++i)
+    for (; borrow && i < (*self)->n; ++i)
     {
-        hugeint_Uint v = (*self)->e[i] + (i < other->n ?
-                        ~(other->e[i]) : ~(hugeint_Uint)0U);
-        unsigned int nextCarry = v < (*self)->e[i];
-        (*self)->e[i] = v + carry;
-        if (!carry || (*self)->e[i]) carry = nextCarry;
+        borrow = !(*self)->e[i]--;
+    }
+    if (borrow)
+    {
+        hugeint_free(*self);
+        *self = 0;
+        return;
     }
     hugeint_autoscale(self);
 }
@@ -553,7 +872,7 @@ void hugeint_subUintFromSelf(hugeint **self, hugeint_Uint other)
     {
         if ((*self)->e[0] < other)
         {
-            free(*self);
+            hugeint_free(*self);
             *self = 0;
             return;
         }
@@ -563,16 +882,13 @@ void hugeint_subUintFromSelf(hugeint **self, hugeint_Uint other)
             return;
         }
     }
-    hugeint_Uint v = (*self)->e[0] + ~other;
-    unsigned int carry = v < ~other;
-    ++(*self)->e[0];
-    for (size_t i = 1; i < (*self)->n; ++i)
+    unsigned int borrow = (*self)->e[0] < other;
+    (*self)->e[0] -= other;
+    for (size_t i = 1; borrow && i < (*self)->n; ++i)
     {
-        (*self)->e[i] += ~0U + carry;
-        carry = carry && !(*self)->e[i];
+        borrow = !(*self)->e[i]--;
     }
     hugeint_autoscale(self);
-
 }
 
 void hugeint_shiftLeft(hugeint **self, size_t positions)
@@ -629,6 +945,8 @@ void hugeint_shiftRight(hugeint **self, size_t positions)
     {
         memmove(&((*self)->e[0]), &((*self)->e[shiftElements]),
                 ((*self)->n - shiftElements) * sizeof(hugeint_Uint));
+        memset(&((*self)->e[(*self)->n - shiftElements]), 0,
+                shiftElements * sizeof(hugeint_Uint));
     }
 
     if (shiftBits)
@@ -648,96 +966,198 @@ void hugeint_shiftRight(hugeint **self, size_t positions)
     hugeint_autoscale(self);
 }
 
-char *hugeint_toString(const hugeint *self)
+void hugeint_multUintToSelf(hugeint **self, hugeint_Uint factor)
 {
-    if (hugeint_isZero(self))
+    if (!factor)
     {
-        char *zero = malloc(2);
-        zero[0] = '0';
-        zero[1] = 0;
-        return zero;
+        *self = hugeint_scale(*self, 1);
+        (*self)->e[0] = 0;
+        return;
     }
+    hugeint_Uint carry = hugeint_limbsMulUint((*self)->e, (*self)->e,
+            (*self)->n, factor);
+    if (carry)
+    {
+        *self = hugeint_scale(*self, (*self)->n + 1);
+        (*self)->e[(*self)->n - 1] = carry;
+    }
+}
 
-    size_t nbits = HUGEINT_ELEMENT_BITS * self->n;
-    size_t bcdsize = nbits/3;
-    size_t scanstart = bcdsize - 2;
-    char *buf = xmalloc(bcdsize + 1);
-    memset(buf, 0, bcdsize + 1);
+void hugeint_addMulUintToSelf(hugeint **self, const hugeint *other,
+        hugeint_Uint factor)
+{
+    if (!factor || hugeint_isZero(other)) return;
+    size_t n = other->n;
+    if ((*self)->n < n) *self = hugeint_scale(*self, n);
 
-    size_t i, j;
+    hugeint_Uint carry = hugeint_limbsAddMulUint((*self)->e, other->e, n,
+            factor);
+    for (size_t i = n; carry && i < (*self)->n; ++i)
+    {
+        (*self)->e[i] += carry;
+        carry = (*self)->e[i] < carry;
+    }
+    if (carry)
+    {
+        *self = hugeint_scale(*self, (*self)->n + 1);
+        (*self)->e[(*self)->n - 1] = carry;
+    }
+}
 
-    i = self->n;
-    while(i--)
+void hugeint_subMulUintFromSelf(hugeint **self, const hugeint *other,
+        hugeint_Uint factor)
+{
+    if (!factor || hugeint_isZero(other)) return;
+    size_t n = other->n;
+    if ((*self)->n < n) *self = hugeint_scale(*self, n);
+
+    hugeint_Uint borrow = hugeint_limbsSubMulUint((*self)->e, other->e, n,
+            factor);
+    for (size_t i = n; borrow && i < (*self)->n; ++i)
     {
-        hugeint_Uint mask = (hugeint_Uint)1U << (HUGEINT_ELEMENT_BITS - 1);
-        while (mask)
-        {
-            int bit = !!(self->e[i] & mask);
-            for (j = scanstart; j < bcdsize; ++j)
-            {
-                if (buf[j] > 4) buf[j] += 3;
-            }
-            if (buf[scanstart] > 7) scanstart -= 1;
-            for (j = scanstart; j < bcdsize - 1; ++j)
-            {
-                buf[j] <<= 1;
-                buf[j] &= 0xf;
-                buf[j] |= (buf[j+1] > 7);
-            }
-            buf[bcdsize-1] <<= 1;
-            buf[bcdsize-1] &= 0xf;
-            buf[bcdsize-1] |= bit;
-            mask >>= 1;
-        }
+        hugeint_Uint v = (*self)->e[i];
+        (*self)->e[i] = v - borrow;
+        borrow = v < borrow;
+    }
+    if (borrow)
+    {
+        hugeint_free(*self);
+        *self = 0;
+        return;
     }
+    hugeint_autoscale(self);
+}
 
-    for (i = 0; i < bcdsize - 1; ++i)
+int hugeint_prepareUintDivisor(hugeint_UintDivisor *divisor, hugeint_Uint d)
+{
+    hugeint_Uint r;
+    divisor->d = d;
+    if (!d)
     {
-        if (buf[i]) break;
+        divisor->shift = 0;
+        divisor->v = 0;
+        return 0;
     }
+    divisor->shift = leadingZeros(d);
+    d <<= divisor->shift;
+    divisor->v = divLimb(~d, ~(hugeint_Uint)0U, d, &r);
+    return 1;
+}
 
-    bcdsize -= i;
-    memmove(buf, buf + i, bcdsize + 1);
+hugeint_Uint hugeint_divPreparedUintToSelf(hugeint **self,
+        const hugeint_UintDivisor *divisor)
+{
+    if (!divisor->d) return 0;
+    hugeint_Uint r = hugeint_limbsDivUint((*self)->e, (*self)->e, (*self)->n,
+            divisor);
+    hugeint_autoscale(self);
+    return r;
+}
 
-    for (i = 0; i < bcdsize; ++i) buf[i] += '0';
-    buf = xrealloc(buf, bcdsize + 1);
-    return buf;
+hugeint_Uint hugeint_divUintToSelf(hugeint **self, hugeint_Uint divisor)
+{
+    hugeint_UintDivisor prepared;
+    if (!divisor) return 0;
+    hugeint_prepareUintDivisor(&prepared, divisor);
+    return hugeint_divPreparedUintToSelf(self, &prepared);
 }
 
-char *hugeint_toHexString(const hugeint *self)
+void hugeint_divExactUintToSelf(hugeint **self, hugeint_Uint divisor)
 {
-    size_t len = self->n * HUGEINT_ELEMENT_BITS / 4;
+    if (!divisor) return;
+    unsigned int shift = trailingZeros(divisor);
+    if (shift)
+    {
+        hugeint_shiftRight(self, shift);
+        divisor >>= shift;
+    }
 
-    hugeint_Uint mask = (hugeint_Uint)0xfU << (HUGEINT_ELEMENT_BITS - 4);
-    while (mask && !(self->e[self->n-1] & mask))
+    hugeint_Uint *e = (*self)->e;
+    hugeint_Uint inv = limbInverse(divisor);
+    hugeint_Uint borrow = 0;
+    for (size_t i = 0; i < (*self)->n; ++i)
     {
-        --len;
-        mask >>= 4;
+        hugeint_Uint v = e[i] - borrow;
+        hugeint_Uint under = e[i] < borrow;
+        e[i] = v * inv;
+        mulLimb(e[i], divisor, &borrow);
+        borrow += under;
     }
-    if (!len)
+    hugeint_autoscale(self);
+}
+
+void hugeint_addShiftedToSelf(hugeint **self, const hugeint *other,
+        size_t limbOffset)
+{
+    if (hugeint_isZero(other)) return;
+    if (other == *self)
     {
-        char *result = malloc(2);
-        result[0] = '0';
-        result[1] = 0;
-        return result;
+        hugeint *tmp = hugeint_clone(other);
+        hugeint_addShiftedToSelf(self, tmp, limbOffset);
+        hugeint_free(tmp);
+        return;
     }
 
-    char *result = malloc(len + 1);
-    result[len] = 0;
+    size_t n = other->n + limbOffset;
+    if ((*self)->n < n) *self = hugeint_scale(*self, n);
 
-    size_t i = 0;
-    while (len)
+    hugeint_Uint *e = &((*self)->e[limbOffset]);
+    hugeint_Uint carry = hugeint_limbsAdd(e, e, other->n, other->e, other->n);
+    for (size_t i = n; carry && i < (*self)->n; ++i)
     {
-        hugeint_Uint v = self->e[i];
-        for (hugeint_Uint j = 0; j < HUGEINT_ELEMENT_BITS / 4; ++j)
-        {
-            unsigned char nibble = v & 0xf;
-            result[--len] = nibble > 9 ? nibble - 10 + 'a' : nibble + '0';
-            if (!len) break;
-            v >>= 4;
-        }
-        ++i;
+        carry = !++(*self)->e[i];
     }
-    return result;
+    if (carry)
+    {
+        *self = hugeint_scale(*self, (*self)->n + 1);
+        (*self)->e[(*self)->n - 1] = 1;
+    }
+    hugeint_autoscale(self);
 }
 
+void hugeint_addShiftedBitsToSelf(hugeint **self, const hugeint *other,
+        size_t bitOffset)
+{
+    size_t limbOffset = bitOffset / HUGEINT_ELEMENT_BITS;
+    unsigned int shift = bitOffset % HUGEINT_ELEMENT_BITS;
+    if (!shift || hugeint_isZero(other))
+    {
+        hugeint_addShiftedToSelf(self, other, limbOffset);
+        return;
+    }
+    if (other == *self)
+    {
+        hugeint *tmp = hugeint_clone(other);
+        hugeint_addShiftedBitsToSelf(self, tmp, bitOffset);
+        hugeint_free(tmp);
+        return;
+    }
+
+    size_t n = other->n + limbOffset + 1;
+    if ((*self)->n < n) *self = hugeint_scale(*self, n);
+
+    hugeint_Uint *e = &((*self)->e[limbOffset]);
+    hugeint_Uint carry = 0;
+    hugeint_Uint prev = 0;
+    for (size_t i = 0; i <= other->n; ++i)
+    {
+        hugeint_Uint cur = i < other->n ? other->e[i] : 0;
+        hugeint_Uint v = (cur << shift)
+                | (prev >> (HUGEINT_ELEMENT_BITS - shift));
+        prev = cur;
+        e[i] += v;
+        hugeint_Uint nextCarry = e[i] < v;
+        e[i] += carry;
+        carry = nextCarry | (e[i] < carry);
+    }
+    for (size_t i = n; carry && i < (*self)->n; ++i)
+    {
+        carry = !++(*self)->e[i];
+    }
+    if (carry)
+    {
+        *self = hugeint_scale(*self, (*self)->n + 1);
+        (*self)->e[(*self)->n - 1] = 1;
+    }
+    hugeint_autoscale(self);
+}
@@ -1,27 +1,118 @@
 #ifndef HUGEINT_H
 #define HUGEINT_H
 
+#include <limits.h>
 #include <stdint.h>
+#include <stdio.h>
+
+#define HUGEINT_SMALL_ELEMENTS ((128 + CHAR_BIT * sizeof(uintmax_t) - 1) \
+        / (CHAR_BIT * sizeof(uintmax_t)))
 
 typedef uintmax_t hugeint_Uint;
 typedef struct hugeint hugeint;
+typedef struct hugeint_ref hugeint_ref;
+typedef struct hugeint_rns hugeint_rns;
+typedef struct hugeint_expr hugeint_expr;
+typedef size_t (*hugeint_Reader)(void *ctx, char *buf, size_t size);
+typedef int (*hugeint_ProgressCallback)(void *ctx, size_t done,
+        size_t remaining);
+
+typedef struct hugeint_UintDivisor
+{
+    hugeint_Uint d;
+    hugeint_Uint v;
+    unsigned int shift;
+} hugeint_UintDivisor;
+
+typedef struct hugeint_small
+{
+    hugeint *big;
+    hugeint_Uint e[HUGEINT_SMALL_ELEMENTS];
+} hugeint_small;
 
+void hugeint_setThreads(unsigned int count);
+unsigned int hugeint_threads(void);
+void hugeint_setGrowthPercent(unsigned int percent);
+/* Values of at least threshold bytes are backed by unlinked files in
+ * directory. Where file mapping is unavailable, or a mapping fails, they
+ * stay on the heap. */
+void hugeint_setStorage(const char *directory, size_t threshold);
+void hugeint_setProgressCallback(hugeint_ProgressCallback callback,
+        void *ctx, size_t granularity);
+/* An outer progress scope measured in caller-defined units. Each step
+ * declares how many of the total units the library calls up to the next
+ * step are worth; their own progress is reported within that share. Step
+ * and End return nonzero once the callback has aborted, and library calls
+ * made inside the scope then return NULL. */
+void hugeint_progressBegin(size_t total);
+int hugeint_progressStep(size_t units);
+int hugeint_progressEnd(void);
+
+/* Values returned by hugeint_create() through hugeint_readHexFrom() are
+ * owned by the caller and must be released with hugeint_free(), not free(),
+ * because large values may be backed by a file mapping. The parsers return
+ * NULL for an unsupported radix or when the progress callback aborts.
+ * hugeint_parse, hugeint_parseBase and the readers skip leading spaces and
+ * tabs, then leading zeros, and stop at the first non-digit, so " 00 5"
+ * yields 0. */
 hugeint *hugeint_create(void);
 hugeint *hugeint_clone(const hugeint *self);
 hugeint *hugeint_fromUint(hugeint_Uint val);
+void hugeint_reserve(hugeint **self, size_t size);
+void hugeint_shrinkToFit(hugeint **self);
+void hugeint_free(hugeint *self);
 hugeint *hugeint_parse(const char *str);
 hugeint *hugeint_parseHex(const char *str);
+hugeint *hugeint_parseBase(const char *str, unsigned int radix);
+hugeint *hugeint_readDecimal(FILE *stream);
+hugeint *hugeint_readHex(FILE *stream);
+hugeint *hugeint_readDecimalFrom(hugeint_Reader reader, void *ctx);
+hugeint *hugeint_readHexFrom(hugeint_Reader reader, void *ctx);
 
+/* Each result is a new value to release with hugeint_free(). NULL means
+ * division by zero, an invalid operand, or an aborted progress callback. */
 hugeint *hugeint_add(const hugeint *a, const hugeint *b);
 hugeint *hugeint_sub(const hugeint *minuend, const hugeint *subtrahend);
 hugeint *hugeint_mult(const hugeint *a, const hugeint *b);
 hugeint *hugeint_div(const hugeint *dividend, const hugeint *divisor,
         hugeint **remainder);
+hugeint *hugeint_divExact(const hugeint *dividend, const hugeint *divisor);
+hugeint *hugeint_sumArray(size_t n, hugeint *const *xs);
+hugeint *hugeint_productArray(size_t n, hugeint *const *xs);
+hugeint *hugeint_pow(const hugeint *base, hugeint_Uint exponent);
+hugeint *hugeint_powUint(hugeint_Uint base, hugeint_Uint exponent);
+hugeint *hugeint_binomial(hugeint_Uint n, hugeint_Uint k);
+hugeint *hugeint_primorial(hugeint_Uint n);
+hugeint *hugeint_fib(hugeint_Uint n);
+hugeint *hugeint_lucas(hugeint_Uint n);
+/* Returns nonzero for probable primes; rounds selects Miller-Rabin bases. */
+int hugeint_isProbablePrime(const hugeint *x, unsigned int rounds);
+void hugeint_isProbablePrimeArray(size_t n, hugeint *const *xs,
+        unsigned int rounds, int *results);
+
+/* Each result is a new value to release with hugeint_free(). */
+hugeint *hugeint_and(const hugeint *a, const hugeint *b);
+hugeint *hugeint_or(const hugeint *a, const hugeint *b);
+hugeint *hugeint_xor(const hugeint *a, const hugeint *b);
+hugeint *hugeint_andnot(const hugeint *a, const hugeint *b);
 
 int hugeint_isZero(const hugeint *self);
 int hugeint_compare(const hugeint *self, const hugeint *other);
 int hugeint_compareUint(const hugeint *self, hugeint_Uint other);
+int hugeint_equal(const hugeint *self, const hugeint *other);
+size_t hugeint_hash(const hugeint *self, size_t seed);
+int hugeint_testBit(const hugeint *self, size_t bit);
+size_t hugeint_popcount(const hugeint *self);
+size_t hugeint_bitLength(const hugeint *self);
+/* Index of the lowest set bit, or SIZE_MAX when self is zero. */
+size_t hugeint_scanLowestSet(const hugeint *self);
+size_t hugeint_decimalDigitsUpperBound(const hugeint *self);
+size_t hugeint_hexDigits(const hugeint *self);
+double hugeint_toDouble(const hugeint *self);
+double hugeint_log2(const hugeint *self);
 
+/* In-place operations may move *self; the pointer they leave behind must
+ * still be released with hugeint_free(). */
 void hugeint_increment(hugeint **self);
 void hugeint_decrement(hugeint **self);
 void hugeint_addToSelf(hugeint **self, const hugeint *other);
@@ -30,8 +121,85 @@ void hugeint_subFromSelf(hugeint **self, const hugeint *other);
 void hugeint_subUintFromSelf(hugeint **self, hugeint_Uint other);
 void hugeint_shiftLeft(hugeint **self, size_t positions);
 void hugeint_shiftRight(hugeint **self, size_t positions);
+void hugeint_andToSelf(hugeint **self, const hugeint *other);
+void hugeint_orToSelf(hugeint **self, const hugeint *other);
+void hugeint_xorToSelf(hugeint **self, const hugeint *other);
+void hugeint_andnotToSelf(hugeint **self, const hugeint *other);
+void hugeint_setBit(hugeint **self, size_t bit);
+void hugeint_addShiftedToSelf(hugeint **self, const hugeint *other,
+        size_t limbOffset);
+void hugeint_addShiftedBitsToSelf(hugeint **self, const hugeint *other,
+        size_t bitOffset);
+void hugeint_multUintToSelf(hugeint **self, hugeint_Uint factor);
+void hugeint_addMulUintToSelf(hugeint **self, const hugeint *other,
+        hugeint_Uint factor);
+void hugeint_subMulUintFromSelf(hugeint **self, const hugeint *other,
+        hugeint_Uint factor);
+/* Returns 0 and prepares nothing usable for d == 0; dividing by such a
+ * divisor leaves the value unchanged and returns 0, like divUintToSelf. */
+int hugeint_prepareUintDivisor(hugeint_UintDivisor *divisor, hugeint_Uint d);
+hugeint_Uint hugeint_divUintToSelf(hugeint **self, hugeint_Uint divisor);
+hugeint_Uint hugeint_divPreparedUintToSelf(hugeint **self,
+        const hugeint_UintDivisor *divisor);
+void hugeint_divExactUintToSelf(hugeint **self, hugeint_Uint divisor);
 
+/* Returned strings are plain heap memory to release with free(). NULL means
+ * the progress callback aborted. The *Into variants write into a caller
+ * buffer sized by the digit bounds above and return the length written. */
 char *hugeint_toString(const hugeint *self);
 char *hugeint_toHexString(const hugeint *self);
+char *hugeint_toStringBase(const hugeint *self, unsigned int radix);
+size_t hugeint_toStringInto(const hugeint *self, char *buf);
+size_t hugeint_toHexStringInto(const hugeint *self, char *buf);
+
+void hugeint_smallInit(hugeint_small *self, hugeint_Uint val);
+void hugeint_smallInitFrom(hugeint_small *self, const hugeint *val);
+void hugeint_smallDone(hugeint_small *self);
+/* Returns a new value to release with hugeint_free(). */
+hugeint *hugeint_smallToHugeint(const hugeint_small *self);
+void hugeint_smallIncrement(hugeint_small *self);
+void hugeint_smallAddUint(hugeint_small *self, hugeint_Uint other);
+void hugeint_smallAdd(hugeint_small *self, const hugeint_small *other);
+int hugeint_smallCompare(const hugeint_small *self, const hugeint_small *other);
+int hugeint_smallCompareUint(const hugeint_small *self, hugeint_Uint other);
+char *hugeint_smallToString(const hugeint_small *self);
+
+/* A ref takes ownership of value. hugeint_refRelease() hands back a value
+ * to release with hugeint_free(). */
+hugeint_ref *hugeint_refCreate(hugeint *value);
+hugeint_ref *hugeint_refClone(hugeint_ref *self);
+void hugeint_refFree(hugeint_ref *self);
+const hugeint *hugeint_refValue(const hugeint_ref *self);
+int hugeint_refIsShared(const hugeint_ref *self);
+hugeint **hugeint_refMutable(hugeint_ref **self);
+hugeint *hugeint_refRelease(hugeint_ref *self);
+
+hugeint_rns *hugeint_rnsCreate(size_t bits);
+void hugeint_rnsFree(hugeint_rns *self);
+size_t hugeint_rnsSize(const hugeint_rns *self);
+/* Returns nonzero if the progress callback aborted; r is then undefined. */
+int hugeint_rnsFromHugeint(const hugeint_rns *self, hugeint_Uint *r,
+        const hugeint *x);
+/* Returns a new value to release with hugeint_free(), or NULL on abort. */
+hugeint *hugeint_rnsToHugeint(const hugeint_rns *self, const hugeint_Uint *r);
+void hugeint_rnsAdd(const hugeint_rns *self, hugeint_Uint *r,
+        const hugeint_Uint *a, const hugeint_Uint *b);
+void hugeint_rnsSub(const hugeint_rns *self, hugeint_Uint *r,
+        const hugeint_Uint *a, const hugeint_Uint *b);
+void hugeint_rnsMul(const hugeint_rns *self, hugeint_Uint *r,
+        const hugeint_Uint *a, const hugeint_Uint *b);
+
+hugeint_expr *hugeint_exprValue(const hugeint *value);
+hugeint_expr *hugeint_exprUint(hugeint_Uint value);
+hugeint_expr *hugeint_exprAdd(hugeint_expr *a, hugeint_expr *b);
+hugeint_expr *hugeint_exprSub(hugeint_expr *minuend, hugeint_expr *subtrahend);
+hugeint_expr *hugeint_exprMult(hugeint_expr *a, hugeint_expr *b);
+hugeint_expr *hugeint_exprDiv(hugeint_expr *dividend, hugeint_expr *divisor);
+hugeint_expr *hugeint_exprClone(hugeint_expr *self);
+void hugeint_exprFree(hugeint_expr *self);
+/* Returns a new value to release with hugeint_free(), or NULL on abort or
+ * division by zero. Evaluation keeps its bookkeeping in the nodes, so two
+ * expressions sharing a subexpression must not be evaluated concurrently. */
+hugeint *hugeint_exprEval(hugeint_expr *self);
 
 #endif
@@ -1,6 +1,7 @@
-hugeint_MODULES:= hugeint
+hugeint_MODULES:= hugeint convert small ref power combinat fib thread bitwise fixed rns storage progress expr prime
 hugeint_V_MAJ:= 0
 hugeint_V_MIN:= 0
 hugeint_V_REV:= 1
+hugeint_LIBS:= pthread m
 $(call librules,hugeint)
 
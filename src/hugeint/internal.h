@@ -0,0 +1,243 @@
+#ifndef HUGEINT_INTERNAL_H
+#define HUGEINT_INTERNAL_H
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "hugeint.h"
+
+#define HUGEINT_ELEMENT_BITS (CHAR_BIT * sizeof(hugeint_Uint))
+#define HUGEINT_INITIAL_ELEMENTS (256 / HUGEINT_ELEMENT_BITS)
+#define HUGEINT_HALF_BITS (HUGEINT_ELEMENT_BITS / 2)
+#define HUGEINT_HALF_MASK (((hugeint_Uint)1U << HUGEINT_HALF_BITS) - 1)
+#define HUGEINT_MULT_THRESHOLD 32
+#define HUGEINT_PROGRESS_LIMBS 64
+
+#if defined(__SIZEOF_INT128__) && UINTMAX_MAX == UINT64_MAX
+__extension__ typedef unsigned __int128 hugeint_Dbl;
+#define HUGEINT_HAVE_DBL
+#endif
+
+struct hugeint
+{
+    size_t s;
+    size_t n;
+    int mapped;
+    hugeint_Uint e[];
+};
+
+struct hugeint_progress;
+
+struct hugeint_fork
+{
+    pthread_t thread;
+    atomic_uint *spare;
+    struct hugeint_progress *progress;
+    void (*run)(void *);
+    void *arg;
+};
+
+static inline void *xmalloc(size_t size)
+{
+    void *m = malloc(size);
+    if (!m) exit(1);
+    return m;
+}
+
+static inline void *xrealloc(void *m, size_t size)
+{
+    void *m2 = realloc(m, size);
+    if (!m2) exit(1);
+    return m2;
+}
+
+static inline hugeint_Uint mulLimb(hugeint_Uint a, hugeint_Uint b,
+        hugeint_Uint *hi)
+{
+#ifdef HUGEINT_HAVE_DBL
+    hugeint_Dbl p = (hugeint_Dbl)a * b;
+    *hi = (hugeint_Uint)(p >> HUGEINT_ELEMENT_BITS);
+    return (hugeint_Uint)p;
+#else
+    hugeint_Uint al = a & HUGEINT_HALF_MASK;
+    hugeint_Uint ah = a >> HUGEINT_HALF_BITS;
+    hugeint_Uint bl = b & HUGEINT_HALF_MASK;
+    hugeint_Uint bh = b >> HUGEINT_HALF_BITS;
+    hugeint_Uint ll = al * bl;
+    hugeint_Uint lh = al * bh;
+    hugeint_Uint hl = ah * bl;
+    hugeint_Uint hh = ah * bh;
+    hugeint_Uint mid = (ll >> HUGEINT_HALF_BITS) + (lh & HUGEINT_HALF_MASK)
+            + (hl & HUGEINT_HALF_MASK);
+    *hi = hh + (lh >> HUGEINT_HALF_BITS) + (hl >> HUGEINT_HALF_BITS)
+            + (mid >> HUGEINT_HALF_BITS);
+    return (mid << HUGEINT_HALF_BITS) | (ll & HUGEINT_HALF_MASK);
+#endif
+}
+
+static inline unsigned int leadingZeros(hugeint_Uint v)
+{
+    unsigned int n = 0;
+    if (!v) return HUGEINT_ELEMENT_BITS;
+    while (!(v & ((hugeint_Uint)1U << (HUGEINT_ELEMENT_BITS - 1))))
+    {
+        v <<= 1;
+        ++n;
+    }
+    return n;
+}
+
+static inline unsigned int trailingZeros(hugeint_Uint v)
+{
+    unsigned int n = 0;
+    if (!v) return HUGEINT_ELEMENT_BITS;
+    while (!(v & 1U))
+    {
+        v >>= 1;
+        ++n;
+    }
+    return n;
+}
+
+static inline hugeint_Uint limbInverse(hugeint_Uint d)
+{
+    hugeint_Uint x = d;
+    for (unsigned int bits = 3; bits < HUGEINT_ELEMENT_BITS; bits *= 2)
+    {
+        x *= 2 - d * x;
+    }
+    return x;
+}
+
+static inline hugeint_Uint divLimb(hugeint_Uint hi, hugeint_Uint lo,
+        hugeint_Uint d, hugeint_Uint *r)
+{
+#ifdef HUGEINT_HAVE_DBL
+    hugeint_Dbl u = ((hugeint_Dbl)hi << HUGEINT_ELEMENT_BITS) | lo;
+    hugeint_Uint q = (hugeint_Uint)(u / d);
+    *r = lo - q * d;
+    return q;
+#else
+    const hugeint_Uint b = (hugeint_Uint)1U << HUGEINT_HALF_BITS;
+    unsigned int s = leadingZeros(d);
+    d <<= s;
+    hugeint_Uint dh = d >> HUGEINT_HALF_BITS;
+    hugeint_Uint dl = d & HUGEINT_HALF_MASK;
+    hugeint_Uint u32 = s ? (hi << s) | (lo >> (HUGEINT_ELEMENT_BITS - s)) : hi;
+    hugeint_Uint u10 = lo << s;
+    hugeint_Uint u1 = u10 >> HUGEINT_HALF_BITS;
+    hugeint_Uint u0 = u10 & HUGEINT_HALF_MASK;
+
+    hugeint_Uint q1 = u32 / dh;
+    hugeint_Uint rhat = u32 - q1 * dh;
+    while (q1 >= b || q1 * dl > b * rhat + u1)
+    {
+        --q1;
+        rhat += dh;
+        if (rhat >= b) break;
+    }
+    hugeint_Uint u21 = u32 * b + u1 - q1 * d;
+
+    hugeint_Uint q0 = u21 / dh;
+    rhat = u21 - q0 * dh;
+    while (q0 >= b || q0 * dl > b * rhat + u0)
+    {
+        --q0;
+        rhat += dh;
+        if (rhat >= b) break;
+    }
+    *r = (u21 * b + u0 - q0 * d) >> s;
+    return q1 * b + q0;
+#endif
+}
+
+static inline hugeint_Uint divLimbPreinv(hugeint_Uint hi, hugeint_Uint lo,
+        hugeint_Uint d, hugeint_Uint v, hugeint_Uint *r)
+{
+    hugeint_Uint qh;
+    hugeint_Uint ql = mulLimb(v, hi, &qh);
+    ql += lo;
+    qh += hi + (ql < lo) + 1;
+    hugeint_Uint rem = lo - qh * d;
+    if (rem > ql)
+    {
+        --qh;
+        rem += d;
+    }
+    if (rem >= d)
+    {
+        ++qh;
+        rem -= d;
+    }
+    *r = rem;
+    return qh;
+}
+
+static inline hugeint_Uint mulMod(hugeint_Uint a, hugeint_Uint b,
+        const hugeint_UintDivisor *m)
+{
+    hugeint_Uint hi;
+    hugeint_Uint lo = mulLimb(a, b, &hi);
+    if (m->shift)
+    {
+        hi = (hi << m->shift) | (lo >> (HUGEINT_ELEMENT_BITS - m->shift));
+        lo <<= m->shift;
+    }
+    hugeint_Uint r;
+    divLimbPreinv(hi, lo, m->d << m->shift, m->v, &r);
+    return r >> m->shift;
+}
+
+static inline hugeint_Uint powMod(hugeint_Uint a, hugeint_Uint e,
+        const hugeint_UintDivisor *m)
+{
+    hugeint_Uint result = 1;
+    while (e)
+    {
+        if (e & 1U) result = mulMod(result, a, m);
+        a = mulMod(a, a, m);
+        e >>= 1;
+    }
+    return result;
+}
+
+hugeint *hugeint_alloc(size_t limbs);
+hugeint *hugeint_realloc(hugeint *self, size_t limbs);
+hugeint *hugeint_scale(hugeint *self, size_t newSize);
+void hugeint_autoscale(hugeint **self);
+hugeint *hugeint_createSized(size_t size);
+void hugeint_spareThreadsInit(atomic_uint *spare);
+int hugeint_forkTry(struct hugeint_fork *self, atomic_uint *spare,
+        void (*run)(void *), void *arg);
+void hugeint_forkStart(struct hugeint_fork *self, atomic_uint *spare,
+        void (*run)(void *), void *arg);
+void hugeint_forkJoin(struct hugeint_fork *self);
+struct hugeint_progress *hugeint_progressInherit(void);
+void hugeint_progressAttach(struct hugeint_progress *progress);
+void hugeint_progressEnter(size_t estimate);
+int hugeint_progressLeave(void);
+int hugeint_progressAdd(size_t work);
+int hugeint_progressAborted(void);
+void hugeint_progressSuspend(void);
+void hugeint_progressResume(void);
+size_t hugeint_multCost(size_t an, size_t bn);
+size_t hugeint_squaringCost(size_t n);
+hugeint_Uint hugeint_limbsAdd(hugeint_Uint *r, const hugeint_Uint *a,
+        size_t an, const hugeint_Uint *b, size_t bn);
+hugeint_Uint hugeint_limbsSub(hugeint_Uint *r, const hugeint_Uint *a,
+        size_t an, const hugeint_Uint *b, size_t bn);
+hugeint_Uint hugeint_limbsMulUint(hugeint_Uint *r, const hugeint_Uint *a,
+        size_t n, hugeint_Uint b);
+hugeint_Uint hugeint_limbsAddMulUint(hugeint_Uint *r, const hugeint_Uint *a,
+        size_t n, hugeint_Uint b);
+hugeint_Uint hugeint_limbsSubMulUint(hugeint_Uint *r, const hugeint_Uint *a,
+        size_t n, hugeint_Uint b);
+void hugeint_limbsDivNorm(hugeint_Uint *q, hugeint_Uint *u, size_t un,
+        const hugeint_Uint *v, size_t vn);
+hugeint_Uint hugeint_limbsDivUint(hugeint_Uint *q, const hugeint_Uint *a,
+        size_t n, const hugeint_UintDivisor *divisor);
+int hugeint_isPrimeUint(hugeint_Uint n);
+
+#endif
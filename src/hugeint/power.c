@@ -0,0 +1,66 @@
+#include "internal.h"
+
+static size_t powCost(size_t n, hugeint_Uint exponent)
+{
+    size_t cost = 0;
+    size_t size = n;
+    unsigned int bit = HUGEINT_ELEMENT_BITS - 1 - leadingZeros(exponent);
+    while (bit--)
+    {
+        cost += hugeint_multCost(size, size);
+        size *= 2;
+        if (!(exponent >> bit & 1U)) continue;
+        cost += hugeint_multCost(size, n);
+        size += n;
+    }
+    return cost;
+}
+
+hugeint *hugeint_pow(const hugeint *base, hugeint_Uint exponent)
+{
+    if (!exponent) return hugeint_fromUint(1);
+    if (hugeint_isZero(base)) return hugeint_create();
+
+    size_t shift = hugeint_scanLowestSet(base);
+    hugeint *odd = hugeint_clone(base);
+    hugeint_shiftRight(&odd, shift);
+
+    hugeint_progressEnter(powCost(odd->n, exponent));
+    hugeint *result = hugeint_clone(odd);
+    unsigned int bit = HUGEINT_ELEMENT_BITS - 1 - leadingZeros(exponent);
+    while (bit--)
+    {
+        hugeint *square = hugeint_mult(result, result);
+        hugeint_free(result);
+        result = square;
+        if (hugeint_progressAborted()) break;
+        if (!(exponent >> bit & 1U)) continue;
+        if (odd->n == 1)
+        {
+            hugeint_multUintToSelf(&result, odd->e[0]);
+        }
+        else
+        {
+            hugeint *product = hugeint_mult(result, odd);
+            hugeint_free(result);
+            result = product;
+        }
+    }
+    hugeint_free(odd);
+
+    if (hugeint_progressLeave())
+    {
+        hugeint_free(result);
+        return 0;
+    }
+    if (shift) hugeint_shiftLeft(&result, shift * exponent);
+    return result;
+}
+
+hugeint *hugeint_powUint(hugeint_Uint base, hugeint_Uint exponent)
+{
+    hugeint *b = hugeint_fromUint(base);
+    hugeint *result = hugeint_pow(b, exponent);
+    hugeint_free(b);
+    return result;
+}
@@ -0,0 +1,348 @@
+#include <string.h>
+
+#include "internal.h"
+
+#define HUGEINT_TRIAL_LIMIT 2048
+#define HUGEINT_PRIME_WINDOW 4
+#define HUGEINT_PRIME_TABLE (1U << (HUGEINT_PRIME_WINDOW - 1))
+
+struct primeGroup
+{
+    hugeint_UintDivisor product;
+    size_t first;
+    size_t count;
+};
+
+struct primeWork
+{
+    size_t size;
+    hugeint_Uint *e;
+};
+
+struct montgomery
+{
+    const hugeint_Uint *m;
+    size_t n;
+    hugeint_Uint inv;
+    hugeint_Uint *t;
+    hugeint_Uint *r2;
+    hugeint_Uint *one;
+    hugeint_Uint *minusOne;
+    hugeint_Uint *x;
+    hugeint_Uint *square;
+    hugeint_Uint *table;
+};
+
+struct primeJob
+{
+    hugeint *const *xs;
+    int *results;
+    size_t n;
+    unsigned int rounds;
+    atomic_size_t *next;
+};
+
+static unsigned int *smallPrimes;
+static struct primeGroup *primeGroups;
+static size_t primeGroupCount;
+static pthread_once_t primeTableOnce = PTHREAD_ONCE_INIT;
+
+int hugeint_isPrimeUint(hugeint_Uint n)
+{
+    static const hugeint_Uint bases[] = {
+        2, 325, 9375, 28178, 450775, 9780504, 1795265022
+    };
+    if (n < 4) return n > 1;
+    if (!(n & 1U)) return 0;
+    hugeint_UintDivisor m;
+    hugeint_prepareUintDivisor(&m, n);
+    hugeint_Uint d = n - 1;
+    unsigned int s = trailingZeros(d);
+    d >>= s;
+
+    for (size_t i = 0; i < sizeof bases / sizeof *bases; ++i)
+    {
+        hugeint_Uint a = bases[i] % n;
+        if (!a) continue;
+        hugeint_Uint x = powMod(a, d, &m);
+        if (x == 1 || x == n - 1) continue;
+        unsigned int j;
+        for (j = 1; j < s; ++j)
+        {
+            x = mulMod(x, x, &m);
+            if (x == n - 1) break;
+        }
+        if (j == s) return 0;
+    }
+    return 1;
+}
+
+static void closeGroup(hugeint_Uint product, size_t first, size_t end)
+{
+    struct primeGroup *group = &primeGroups[primeGroupCount++];
+    hugeint_prepareUintDivisor(&group->product, product);
+    group->first = first;
+    group->count = end - first;
+}
+
+static void primeTableInit(void)
+{
+    char *composite = xmalloc(HUGEINT_TRIAL_LIMIT);
+    memset(composite, 0, HUGEINT_TRIAL_LIMIT);
+    smallPrimes = xmalloc(HUGEINT_TRIAL_LIMIT / 2 * sizeof *smallPrimes);
+    primeGroups = xmalloc(HUGEINT_TRIAL_LIMIT / 2 * sizeof *primeGroups);
+
+    size_t count = 0;
+    size_t first = 0;
+    hugeint_Uint product = 1;
+    for (unsigned int p = 3; p < HUGEINT_TRIAL_LIMIT; p += 2)
+    {
+        if (composite[p]) continue;
+        for (unsigned int m = p * p; m < HUGEINT_TRIAL_LIMIT; m += 2 * p)
+        {
+            composite[m] = 1;
+        }
+        hugeint_Uint hi;
+        hugeint_Uint next = mulLimb(product, p, &hi);
+        if (hi)
+        {
+            closeGroup(product, first, count);
+            first = count;
+            next = p;
+        }
+        product = next;
+        smallPrimes[count++] = p;
+    }
+    closeGroup(product, first, count);
+    free(composite);
+}
+
+static int hasSmallFactor(const hugeint *x)
+{
+    for (size_t i = 0; i < primeGroupCount; ++i)
+    {
+        const struct primeGroup *group = &primeGroups[i];
+        hugeint_Uint r = hugeint_limbsDivUint(0, x->e, x->n,
+                &group->product);
+        for (size_t j = group->first; j < group->first + group->count; ++j)
+        {
+            if (!(r % smallPrimes[j])) return 1;
+        }
+    }
+    return 0;
+}
+
+static int limbsCompare(const hugeint_Uint *a, const hugeint_Uint *b,
+        size_t n)
+{
+    while (n--)
+    {
+        if (a[n] != b[n]) return a[n] > b[n] ? 1 : -1;
+    }
+    return 0;
+}
+
+static int bitAt(const hugeint_Uint *e, size_t bit)
+{
+    return e[bit / HUGEINT_ELEMENT_BITS] >> (bit % HUGEINT_ELEMENT_BITS) & 1U;
+}
+
+static void montMul(const struct montgomery *self, hugeint_Uint *r,
+        const hugeint_Uint *a, const hugeint_Uint *b)
+{
+    size_t n = self->n;
+    hugeint_Uint *t = self->t;
+    memset(t, 0, (2 * n + 1) * sizeof *t);
+    for (size_t i = 0; i < n; ++i)
+    {
+        t[i + n] = hugeint_limbsAddMulUint(&(t[i]), a, n, b[i]);
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        hugeint_Uint carry = hugeint_limbsAddMulUint(&(t[i]), self->m, n,
+                t[i] * self->inv);
+        for (size_t j = i + n; carry; ++j)
+        {
+            t[j] += carry;
+            carry = t[j] < carry;
+        }
+    }
+    if (t[2 * n] || limbsCompare(&(t[n]), self->m, n) >= 0)
+    {
+        hugeint_limbsSub(r, &(t[n]), n, self->m, n);
+    }
+    else memcpy(r, &(t[n]), n * sizeof *r);
+}
+
+static void montInit(struct montgomery *self, const hugeint *m,
+        struct primeWork *work)
+{
+    size_t n = m->n;
+    size_t size = 15 * n + 1;
+    if (work->size < size)
+    {
+        work->e = xrealloc(work->e, size * sizeof *work->e);
+        work->size = size;
+    }
+    self->m = m->e;
+    self->n = n;
+    self->inv = -limbInverse(m->e[0]);
+    self->t = work->e;
+    self->r2 = self->t + 2 * n + 1;
+    self->one = self->r2 + n;
+    self->minusOne = self->one + n;
+    self->x = self->minusOne + n;
+    self->square = self->x + n;
+    self->table = self->square + n;
+
+    hugeint_Uint *u = self->table;
+    hugeint_Uint *v = u + 2 * n + 2;
+    hugeint_Uint *q = v + n;
+    unsigned int shift = leadingZeros(m->e[n - 1]);
+    memset(u, 0, (2 * n + 2) * sizeof *u);
+    u[2 * n] = (hugeint_Uint)1U << shift;
+    memcpy(v, m->e, n * sizeof *v);
+    if (shift)
+    {
+        for (size_t i = n - 1; i > 0; --i)
+        {
+            v[i] = (v[i] << shift)
+                    | (v[i - 1] >> (HUGEINT_ELEMENT_BITS - shift));
+        }
+        v[0] <<= shift;
+    }
+    hugeint_limbsDivNorm(q, u, 2 * n + 1, v, n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        self->r2[i] = shift ? (u[i] >> shift)
+                | (u[i + 1] << (HUGEINT_ELEMENT_BITS - shift)) : u[i];
+    }
+
+    memset(self->x, 0, n * sizeof *self->x);
+    self->x[0] = 1;
+    montMul(self, self->one, self->r2, self->x);
+    hugeint_limbsSub(self->minusOne, self->m, n, self->one, n);
+}
+
+static void montPow(const struct montgomery *self, size_t top, size_t low)
+{
+    size_t n = self->n;
+    hugeint_Uint *x = self->x;
+    memcpy(x, self->one, n * sizeof *x);
+    size_t i = top + 1;
+    while (i > low)
+    {
+        if (!bitAt(self->m, i - 1))
+        {
+            montMul(self, x, x, x);
+            --i;
+            continue;
+        }
+        size_t j = i - low > HUGEINT_PRIME_WINDOW
+                ? i - HUGEINT_PRIME_WINDOW : low;
+        while (!bitAt(self->m, j)) ++j;
+        unsigned int value = 0;
+        for (; i > j; --i)
+        {
+            montMul(self, x, x, x);
+            value = value << 1 | bitAt(self->m, i - 1);
+        }
+        montMul(self, x, x, &(self->table[(value >> 1) * n]));
+    }
+}
+
+static int millerRabin(const struct montgomery *self, hugeint_Uint base,
+        size_t top, size_t s)
+{
+    size_t n = self->n;
+    hugeint_Uint *x = self->x;
+    memset(x, 0, n * sizeof *x);
+    x[0] = base;
+    montMul(self, self->table, x, self->r2);
+    montMul(self, self->square, self->table, self->table);
+    for (size_t k = 1; k < HUGEINT_PRIME_TABLE; ++k)
+    {
+        montMul(self, &(self->table[k * n]), &(self->table[(k - 1) * n]),
+                self->square);
+    }
+
+    montPow(self, top, s);
+    if (!limbsCompare(x, self->one, n)) return 1;
+    for (size_t r = 0; r < s; ++r)
+    {
+        if (!limbsCompare(x, self->minusOne, n)) return 1;
+        if (r + 1 < s) montMul(self, x, x, x);
+    }
+    return 0;
+}
+
+static hugeint_Uint nextBase(hugeint_Uint *state)
+{
+    hugeint_Uint z = (*state += 0x9e3779b97f4a7c15U);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9U;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebU;
+    z ^= z >> 31;
+    return z < 2 ? z + 2 : z;
+}
+
+static int probablePrime(const hugeint *x, unsigned int rounds,
+        struct primeWork *work)
+{
+    if (x->n == 1) return hugeint_isPrimeUint(x->e[0]);
+    if (!(x->e[0] & 1U)) return 0;
+    pthread_once(&primeTableOnce, primeTableInit);
+    if (hasSmallFactor(x)) return 0;
+
+    struct montgomery mont;
+    montInit(&mont, x, work);
+    size_t s = 1;
+    while (!bitAt(x->e, s)) ++s;
+    size_t top = hugeint_bitLength(x) - 1;
+    hugeint_Uint state = x->e[0] ^ x->e[x->n - 1] ^ x->n;
+    if (!rounds) rounds = 1;
+    while (rounds--)
+    {
+        if (!millerRabin(&mont, nextBase(&state), top, s)) return 0;
+    }
+    return 1;
+}
+
+int hugeint_isProbablePrime(const hugeint *x, unsigned int rounds)
+{
+    struct primeWork work = { 0, 0 };
+    int result = probablePrime(x, rounds, &work);
+    free(work.e);
+    return result;
+}
+
+static void primeWorker(void *arg)
+{
+    struct primeJob *job = arg;
+    struct primeWork work = { 0, 0 };
+    size_t i;
+    while ((i = atomic_fetch_add(job->next, 1)) < job->n)
+    {
+        job->results[i] = probablePrime(job->xs[i], job->rounds, &work);
+    }
+    free(work.e);
+}
+
+void hugeint_isProbablePrimeArray(size_t n, hugeint *const *xs,
+        unsigned int rounds, int *results)
+{
+    atomic_size_t next;
+    atomic_init(&next, 0);
+    struct primeJob job = { xs, results, n, rounds, &next };
+    unsigned int workers = hugeint_threads();
+    if (workers > n) workers = n ? n : 1;
+    struct hugeint_fork *forks = xmalloc(workers * sizeof *forks);
+    atomic_uint spare;
+    hugeint_spareThreadsInit(&spare);
+    for (unsigned int i = 1; i < workers; ++i)
+    {
+        hugeint_forkStart(&forks[i], &spare, primeWorker, &job);
+    }
+    primeWorker(&job);
+    for (unsigned int i = 1; i < workers; ++i) hugeint_forkJoin(&forks[i]);
+    free(forks);
+}
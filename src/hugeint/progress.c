@@ -0,0 +1,172 @@
+#include "internal.h"
+
+struct hugeint_progress
+{
+    hugeint_ProgressCallback callback;
+    void *ctx;
+    size_t granularity;
+    size_t estimate;
+    size_t total;
+    size_t base;
+    size_t step;
+    size_t shown;
+    atomic_size_t done;
+    atomic_size_t next;
+    atomic_flag reporting;
+    atomic_int aborted;
+};
+
+static _Thread_local struct hugeint_progress threadProgress;
+static _Thread_local struct hugeint_progress *current;
+static _Thread_local unsigned int depth;
+static _Thread_local unsigned int scope;
+static _Thread_local unsigned int suspended;
+
+static void report(struct hugeint_progress *self, size_t done)
+{
+    if (atomic_flag_test_and_set(&self->reporting)) return;
+    size_t remaining = self->estimate > done ? self->estimate - done : 0;
+    if (self->total)
+    {
+        size_t within = 0;
+        if (self->estimate) within = remaining ? (size_t)((double)self->step
+                * done / self->estimate) : self->step;
+        if (self->base + within > self->shown) self->shown = self->base + within;
+        done = self->shown;
+        remaining = self->total > done ? self->total - done : 0;
+    }
+    if (self->callback(self->ctx, done, remaining))
+    {
+        atomic_store(&self->aborted, 1);
+    }
+    atomic_flag_clear(&self->reporting);
+}
+
+void hugeint_setProgressCallback(hugeint_ProgressCallback callback,
+        void *ctx, size_t granularity)
+{
+    if (!callback)
+    {
+        threadProgress.total = 0;
+        current = 0;
+        depth = 0;
+        scope = 0;
+        return;
+    }
+    threadProgress.callback = callback;
+    threadProgress.ctx = ctx;
+    threadProgress.granularity = granularity ? granularity : 1;
+    atomic_flag_clear(&threadProgress.reporting);
+    current = &threadProgress;
+}
+
+struct hugeint_progress *hugeint_progressInherit(void)
+{
+    return suspended ? 0 : current;
+}
+
+void hugeint_progressAttach(struct hugeint_progress *progress)
+{
+    current = progress;
+    depth = !!progress;
+}
+
+void hugeint_progressEnter(size_t estimate)
+{
+    struct hugeint_progress *self = current;
+    if (!self || depth++ > scope) return;
+    if (scope)
+    {
+        self->estimate += estimate;
+        return;
+    }
+    self->estimate = estimate;
+    atomic_store(&self->done, 0);
+    atomic_store(&self->next, self->granularity);
+    atomic_store(&self->aborted, 0);
+}
+
+int hugeint_progressLeave(void)
+{
+    struct hugeint_progress *self = current;
+    if (!self || --depth > scope) return 0;
+    if (hugeint_progressAborted()) return 1;
+    if (depth) return 0;
+    size_t done = atomic_load(&self->done);
+    if (self->total)
+    {
+        self->base += self->step;
+        self->step = 0;
+        self->total = self->base;
+        report(self, done);
+        self->total = 0;
+    }
+    else if (done >= self->granularity)
+    {
+        self->estimate = done;
+        report(self, done);
+    }
+    return 0;
+}
+
+void hugeint_progressBegin(size_t total)
+{
+    struct hugeint_progress *self = current;
+    if (!self || depth) return;
+    hugeint_progressEnter(0);
+    scope = depth;
+    self->total = total ? total : 1;
+    self->base = 0;
+    self->step = 0;
+    self->shown = 0;
+}
+
+int hugeint_progressStep(size_t units)
+{
+    struct hugeint_progress *self = current;
+    if (!self || !scope) return 0;
+    self->base += self->step;
+    self->step = units;
+    self->estimate = 0;
+    atomic_store(&self->done, 0);
+    atomic_store(&self->next, self->granularity);
+    report(self, 0);
+    return hugeint_progressAborted();
+}
+
+int hugeint_progressEnd(void)
+{
+    if (!scope) return 0;
+    scope = 0;
+    return hugeint_progressLeave();
+}
+
+int hugeint_progressAdd(size_t work)
+{
+    struct hugeint_progress *self = current;
+    if (!self) return 0;
+    size_t done = atomic_fetch_add(&self->done, work) + work;
+    size_t next = atomic_load(&self->next);
+    if (!suspended && done >= next
+            && atomic_compare_exchange_strong(&self->next, &next,
+                done + self->granularity))
+    {
+        report(self, done);
+    }
+    return hugeint_progressAborted();
+}
+
+int hugeint_progressAborted(void)
+{
+    return current && !suspended && atomic_load(&current->aborted);
+}
+
+void hugeint_progressSuspend(void)
+{
+    ++suspended;
+}
+
+void hugeint_progressResume(void)
+{
+    --suspended;
+}
@@ -0,0 +1,67 @@
+#include <stdatomic.h>
+
+#include "internal.h"
+
+struct hugeint_ref
+{
+    atomic_size_t refs;
+    hugeint *value;
+};
+
+hugeint_ref *hugeint_refCreate(hugeint *value)
+{
+    hugeint_ref *self = xmalloc(sizeof *self);
+    atomic_init(&self->refs, 1);
+    self->value = value;
+    return self;
+}
+
+hugeint_ref *hugeint_refClone(hugeint_ref *self)
+{
+    atomic_fetch_add_explicit(&self->refs, 1, memory_order_relaxed);
+    return self;
+}
+
+void hugeint_refFree(hugeint_ref *self)
+{
+    if (!self) return;
+    if (atomic_fetch_sub_explicit(&self->refs, 1, memory_order_acq_rel) == 1)
+    {
+        hugeint_free(self->value);
+        free(self);
+    }
+}
+
+const hugeint *hugeint_refValue(const hugeint_ref *self)
+{
+    return self->value;
+}
+
+int hugeint_refIsShared(const hugeint_ref *self)
+{
+    return atomic_load_explicit(&self->refs, memory_order_acquire) > 1;
+}
+
+hugeint **hugeint_refMutable(hugeint_ref **self)
+{
+    if (hugeint_refIsShared(*self))
+    {
+        hugeint_ref *copy = hugeint_refCreate(hugeint_clone((*self)->value));
+        hugeint_refFree(*self);
+        *self = copy;
+    }
+    return &(*self)->value;
+}
+
+hugeint *hugeint_refRelease(hugeint_ref *self)
+{
+    if (hugeint_refIsShared(self))
+    {
+        hugeint *value = hugeint_clone(self->value);
+        hugeint_refFree(self);
+        return value;
+    }
+    hugeint *value = self->value;
+    free(self);
+    return value;
+}
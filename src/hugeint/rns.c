@@ -0,0 +1,310 @@
+#include <string.h>
+
+#include "internal.h"
+
+#define HUGEINT_RNS_PRIME_BITS 62
+#define HUGEINT_RNS_LEAF 16
+#define HUGEINT_RNS_PARALLEL_LIMBS 256
+#define HUGEINT_RNS_PARALLEL_RESIDUES 4096
+
+struct hugeint_rns
+{
+    size_t count;
+    hugeint_UintDivisor *moduli;
+    hugeint_Uint *inverses;
+    hugeint **tree;
+};
+
+enum pointwiseOp
+{
+    RNS_ADD,
+    RNS_SUB,
+    RNS_MUL
+};
+
+struct pointwiseJob
+{
+    const hugeint_rns *rns;
+    enum pointwiseOp op;
+    hugeint_Uint *r;
+    const hugeint_Uint *a;
+    const hugeint_Uint *b;
+    size_t lo;
+    size_t hi;
+    atomic_uint *spare;
+};
+
+struct reduceJob
+{
+    const hugeint_rns *rns;
+    size_t node;
+    size_t lo;
+    size_t hi;
+    const hugeint *x;
+    hugeint_Uint *r;
+    atomic_uint *spare;
+};
+
+struct combineJob
+{
+    const hugeint_rns *rns;
+    size_t node;
+    size_t lo;
+    size_t hi;
+    const hugeint_Uint *c;
+    atomic_uint *spare;
+    hugeint *result;
+};
+
+static void buildTree(hugeint_rns *self, size_t node, size_t lo, size_t hi)
+{
+    if (hi - lo == 1)
+    {
+        self->tree[node] = hugeint_fromUint(self->moduli[lo].d);
+        return;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    buildTree(self, 2 * node, lo, mid);
+    buildTree(self, 2 * node + 1, mid, hi);
+    self->tree[node] = hugeint_mult(self->tree[2 * node],
+            self->tree[2 * node + 1]);
+}
+
+static void cofactors(hugeint_rns *self, size_t node, size_t lo, size_t hi,
+        const hugeint *x)
+{
+    if (hi - lo == 1)
+    {
+        hugeint *t = hugeint_clone(x);
+        hugeint_divUintToSelf(&t, self->moduli[lo].d);
+        self->inverses[lo] = powMod(t->e[0], self->moduli[lo].d - 2,
+                &self->moduli[lo]);
+        hugeint_free(t);
+        return;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    for (size_t child = 2 * node; child <= 2 * node + 1; ++child)
+    {
+        hugeint *square = hugeint_mult(self->tree[child], self->tree[child]);
+        hugeint *r;
+        hugeint_free(hugeint_div(x, square, &r));
+        hugeint_free(square);
+        if (child == 2 * node) cofactors(self, child, lo, mid, r);
+        else cofactors(self, child, mid, hi, r);
+        hugeint_free(r);
+    }
+}
+
+hugeint_rns *hugeint_rnsCreate(size_t bits)
+{
+    hugeint_rns *self = xmalloc(sizeof *self);
+    self->count = bits / (HUGEINT_RNS_PRIME_BITS - 1) + 2;
+    self->moduli = xmalloc(self->count * sizeof *self->moduli);
+    self->inverses = xmalloc(self->count * sizeof *self->inverses);
+    self->tree = xmalloc(4 * self->count * sizeof *self->tree);
+    memset(self->tree, 0, 4 * self->count * sizeof *self->tree);
+
+    hugeint_Uint candidate = ((hugeint_Uint)1U << HUGEINT_RNS_PRIME_BITS) - 1;
+    for (size_t i = 0; i < self->count; candidate -= 2)
+    {
+        if (hugeint_isPrimeUint(candidate))
+        {
+            hugeint_prepareUintDivisor(&self->moduli[i++], candidate);
+        }
+    }
+
+    hugeint_progressSuspend();
+    buildTree(self, 1, 0, self->count);
+    cofactors(self, 1, 0, self->count, self->tree[1]);
+    hugeint_progressResume();
+    return self;
+}
+
+void hugeint_rnsFree(hugeint_rns *self)
+{
+    if (!self) return;
+    for (size_t i = 0; i < 4 * self->count; ++i) hugeint_free(self->tree[i]);
+    free(self->tree);
+    free(self->inverses);
+    free(self->moduli);
+    free(self);
+}
+
+size_t hugeint_rnsSize(const hugeint_rns *self)
+{
+    return self->count;
+}
+
+static void pointwise(void *arg)
+{
+    const struct pointwiseJob *job = arg;
+    if (job->hi - job->lo >= 2 * HUGEINT_RNS_PARALLEL_RESIDUES)
+    {
+        struct pointwiseJob high = *job;
+        struct pointwiseJob low = *job;
+        low.hi = high.lo = job->lo + (job->hi - job->lo) / 2;
+        struct hugeint_fork fork;
+        hugeint_forkStart(&fork, job->spare, pointwise, &high);
+        pointwise(&low);
+        hugeint_forkJoin(&fork);
+        return;
+    }
+
+    const hugeint_UintDivisor *m = job->rns->moduli;
+    hugeint_Uint *r = job->r;
+    const hugeint_Uint *a = job->a;
+    const hugeint_Uint *b = job->b;
+    switch (job->op)
+    {
+        case RNS_ADD:
+            for (size_t i = job->lo; i < job->hi; ++i)
+            {
+                hugeint_Uint s = a[i] + b[i];
+                r[i] = s - (m[i].d & -(hugeint_Uint)(s >= m[i].d));
+            }
+            break;
+        case RNS_SUB:
+            for (size_t i = job->lo; i < job->hi; ++i)
+            {
+                hugeint_Uint d = a[i] - b[i];
+                r[i] = d + (m[i].d & -(hugeint_Uint)(a[i] < b[i]));
+            }
+            break;
+        case RNS_MUL:
+            for (size_t i = job->lo; i < job->hi; ++i)
+            {
+                r[i] = mulMod(a[i], b[i], &m[i]);
+            }
+            break;
+    }
+}
+
+static void runPointwise(const hugeint_rns *self, enum pointwiseOp op,
+        hugeint_Uint *r, const hugeint_Uint *a, const hugeint_Uint *b)
+{
+    atomic_uint spare;
+    hugeint_spareThreadsInit(&spare);
+    struct pointwiseJob job = {self, op, r, a, b, 0, self->count, &spare};
+    pointwise(&job);
+}
+
+void hugeint_rnsAdd(const hugeint_rns *self, hugeint_Uint *r,
+        const hugeint_Uint *a, const hugeint_Uint *b)
+{
+    runPointwise(self, RNS_ADD, r, a, b);
+}
+
+void hugeint_rnsSub(const hugeint_rns *self, hugeint_Uint *r,
+        const hugeint_Uint *a, const hugeint_Uint *b)
+{
+    runPointwise(self, RNS_SUB, r, a, b);
+}
+
+void hugeint_rnsMul(const hugeint_rns *self, hugeint_Uint *r,
+        const hugeint_Uint *a, const hugeint_Uint *b)
+{
+    runPointwise(self, RNS_MUL, r, a, b);
+}
+
+static void reduce(void *arg)
+{
+    const struct reduceJob *job = arg;
+    if (job->hi - job->lo <= HUGEINT_RNS_LEAF)
+    {
+        for (size_t i = job->lo; i < job->hi; ++i)
+        {
+            job->r[i] = hugeint_limbsDivUint(0, job->x->e, job->x->n,
+                    &job->rns->moduli[i]);
+        }
+        return;
+    }
+
+    struct reduceJob high = *job;
+    struct reduceJob low = *job;
+    low.node = 2 * job->node;
+    high.node = low.node + 1;
+    low.hi = high.lo = job->lo + (job->hi - job->lo) / 2;
+    hugeint *lowX;
+    hugeint *highX;
+    hugeint_free(hugeint_div(job->x, job->rns->tree[low.node], &lowX));
+    hugeint_free(hugeint_div(job->x, job->rns->tree[high.node], &highX));
+    low.x = lowX;
+    high.x = highX;
+
+    struct hugeint_fork fork;
+    hugeint_forkStart(&fork, job->x->n >= HUGEINT_RNS_PARALLEL_LIMBS
+            ? job->spare : 0, reduce, &high);
+    reduce(&low);
+    hugeint_forkJoin(&fork);
+    hugeint_free(lowX);
+    hugeint_free(highX);
+}
+
+int hugeint_rnsFromHugeint(const hugeint_rns *self, hugeint_Uint *r,
+        const hugeint *x)
+{
+    hugeint *reduced;
+    size_t n = self->tree[1]->n;
+    hugeint_progressEnter((x->n + 2 * n) * n);
+    hugeint_free(hugeint_div(x, self->tree[1], &reduced));
+    atomic_uint spare;
+    hugeint_spareThreadsInit(&spare);
+    struct reduceJob job = {self, 1, 0, self->count, reduced, r, &spare};
+    reduce(&job);
+    hugeint_free(reduced);
+    return hugeint_progressLeave();
+}
+
+static void combine(void *arg)
+{
+    struct combineJob *job = arg;
+    if (job->hi - job->lo == 1)
+    {
+        job->result = hugeint_fromUint(job->c[job->lo]);
+        return;
+    }
+
+    struct combineJob high = *job;
+    struct combineJob low = *job;
+    low.node = 2 * job->node;
+    high.node = low.node + 1;
+    low.hi = high.lo = job->lo + (job->hi - job->lo) / 2;
+    struct hugeint_fork fork;
+    hugeint_forkStart(&fork, job->rns->tree[job->node]->n
+            >= HUGEINT_RNS_PARALLEL_LIMBS ? job->spare : 0, combine, &high);
+    combine(&low);
+    hugeint_forkJoin(&fork);
+
+    job->result = hugeint_mult(low.result, job->rns->tree[high.node]);
+    hugeint *t = hugeint_mult(high.result, job->rns->tree[low.node]);
+    hugeint_addToSelf(&job->result, t);
+    hugeint_free(t);
+    hugeint_free(low.result);
+    hugeint_free(high.result);
+}
+
+hugeint *hugeint_rnsToHugeint(const hugeint_rns *self, const hugeint_Uint *r)
+{
+    hugeint_Uint *c = xmalloc(self->count * sizeof *c);
+    for (size_t i = 0; i < self->count; ++i)
+    {
+        c[i] = mulMod(r[i], self->inverses[i], &self->moduli[i]);
+    }
+    atomic_uint spare;
+    hugeint_spareThreadsInit(&spare);
+    struct combineJob job = {self, 1, 0, self->count, c, &spare, 0};
+    size_t n = self->tree[1]->n;
+    hugeint_progressEnter(2 * hugeint_squaringCost(n) + n * n);
+    combine(&job);
+    free(c);
+
+    hugeint *result;
+    hugeint_free(hugeint_div(job.result, self->tree[1], &result));
+    hugeint_free(job.result);
+    if (hugeint_progressLeave())
+    {
+        hugeint_free(result);
+        return 0;
+    }
+    return result;
+}
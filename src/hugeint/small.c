@@ -0,0 +1,165 @@
+#include <string.h>
+
+#include "internal.h"
+
+static void spill(hugeint_small *self, hugeint_Uint carry)
+{
+    self->big = hugeint_createSized(HUGEINT_SMALL_ELEMENTS + 1);
+    memcpy(self->big->e, self->e, sizeof self->e);
+    self->big->e[HUGEINT_SMALL_ELEMENTS] = carry;
+    hugeint_autoscale(&self->big);
+}
+
+static void limbs(const hugeint_small *self, const hugeint_Uint **e,
+        size_t *n)
+{
+    if (self->big)
+    {
+        *e = self->big->e;
+        *n = self->big->n;
+    }
+    else
+    {
+        *e = self->e;
+        *n = HUGEINT_SMALL_ELEMENTS;
+    }
+}
+
+void hugeint_smallInit(hugeint_small *self, hugeint_Uint val)
+{
+    self->big = 0;
+    memset(self->e, 0, sizeof self->e);
+    self->e[0] = val;
+}
+
+void hugeint_smallInitFrom(hugeint_small *self, const hugeint *val)
+{
+    size_t n = val->n;
+    if (n > HUGEINT_SMALL_ELEMENTS)
+    {
+        self->big = hugeint_clone(val);
+        return;
+    }
+    self->big = 0;
+    memset(self->e, 0, sizeof self->e);
+    memcpy(self->e, val->e, n * sizeof *self->e);
+}
+
+void hugeint_smallDone(hugeint_small *self)
+{
+    hugeint_free(self->big);
+    self->big = 0;
+}
+
+hugeint *hugeint_smallToHugeint(const hugeint_small *self)
+{
+    if (self->big) return hugeint_clone(self->big);
+    hugeint *result = hugeint_createSized(HUGEINT_SMALL_ELEMENTS);
+    memcpy(result->e, self->e, sizeof self->e);
+    hugeint_autoscale(&result);
+    return result;
+}
+
+void hugeint_smallIncrement(hugeint_small *self)
+{
+    if (self->big)
+    {
+        hugeint_increment(&self->big);
+        return;
+    }
+    for (size_t i = 0; i < HUGEINT_SMALL_ELEMENTS; ++i)
+    {
+        if (++self->e[i]) return;
+    }
+    spill(self, 1);
+}
+
+void hugeint_smallAddUint(hugeint_small *self, hugeint_Uint other)
+{
+    if (self->big)
+    {
+        hugeint_addUintToSelf(&self->big, other);
+        return;
+    }
+    self->e[0] += other;
+    if (self->e[0] >= other) return;
+    for (size_t i = 1; i < HUGEINT_SMALL_ELEMENTS; ++i)
+    {
+        if (++self->e[i]) return;
+    }
+    spill(self, 1);
+}
+
+void hugeint_smallAdd(hugeint_small *self, const hugeint_small *other)
+{
+    if (other->big)
+    {
+        if (!self->big) self->big = hugeint_smallToHugeint(self);
+        hugeint_addToSelf(&self->big, other->big);
+        return;
+    }
+    if (self->big)
+    {
+        hugeint *tmp = hugeint_smallToHugeint(other);
+        hugeint_addToSelf(&self->big, tmp);
+        hugeint_free(tmp);
+        return;
+    }
+
+    hugeint_Uint carry = 0;
+    for (size_t i = 0; i < HUGEINT_SMALL_ELEMENTS; ++i)
+    {
+        hugeint_Uint v = self->e[i] + other->e[i];
+        hugeint_Uint nextCarry = v < other->e[i];
+        self->e[i] = v + carry;
+        nextCarry += self->e[i] < carry;
+        carry = nextCarry;
+    }
+    if (carry) spill(self, carry);
+}
+
+int hugeint_smallCompare(const hugeint_small *self, const hugeint_small *other)
+{
+    const hugeint_Uint *a;
+    const hugeint_Uint *b;
+    size_t an;
+    size_t bn;
+    limbs(self, &a, &an);
+    limbs(other, &b, &bn);
+
+    while (an > bn)
+    {
+        if (a[--an]) return 1;
+    }
+    while (bn > an)
+    {
+        if (b[--bn]) return -1;
+    }
+    while (an--)
+    {
+        if (a[an] > b[an]) return 1;
+        if (a[an] < b[an]) return -1;
+    }
+    return 0;
+}
+
+int hugeint_smallCompareUint(const hugeint_small *self, hugeint_Uint other)
+{
+    if (self->big) return hugeint_compareUint(self->big, other);
+    for (size_t i = HUGEINT_SMALL_ELEMENTS - 1; i > 0; --i)
+    {
+        if (self->e[i]) return 1;
+    }
+    if (self->e[0] > other) return 1;
+    if (self->e[0] < other) return -1;
+    return 0;
+}
+
+char *hugeint_smallToString(const hugeint_small *self)
+{
+    if (self->big) return hugeint_toString(self->big);
+    hugeint *tmp = hugeint_smallToHugeint(self);
+    char *result = hugeint_toString(tmp);
+    hugeint_free(tmp);
+    return result;
+}
@@ -0,0 +1,198 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#define HUGEINT_HAVE_MMAP
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#ifdef HUGEINT_HAVE_MMAP
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "internal.h"
+
+static char *storageDirectory;
+static atomic_size_t storageThreshold = SIZE_MAX;
+static pthread_mutex_t storageLock = PTHREAD_MUTEX_INITIALIZER;
+
+static size_t limbBytes(size_t limbs)
+{
+    return sizeof(hugeint) + limbs * sizeof(hugeint_Uint);
+}
+
+#ifdef HUGEINT_HAVE_MMAP
+struct mapping
+{
+    struct mapping *next;
+    void *addr;
+    size_t len;
+    int fd;
+};
+
+static struct mapping *mappings;
+
+static size_t pageBytes(size_t bytes)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    return (bytes + page - 1) / page * page;
+}
+
+static struct mapping **findMapping(void *addr)
+{
+    struct mapping **m = &mappings;
+    while (*m && (*m)->addr != addr) m = &(*m)->next;
+    return m;
+}
+
+static void *mapFile(size_t bytes)
+{
+    void *addr = 0;
+    pthread_mutex_lock(&storageLock);
+    if (!storageDirectory) goto done;
+
+    size_t pathLen = strlen(storageDirectory) + sizeof "/hugeintXXXXXX";
+    char *path = xmalloc(pathLen);
+    snprintf(path, pathLen, "%s/hugeintXXXXXX", storageDirectory);
+    int fd = mkstemp(path);
+    if (fd >= 0) unlink(path);
+    free(path);
+    if (fd < 0) goto done;
+
+    size_t len = pageBytes(bytes);
+    if (ftruncate(fd, (off_t)len) < 0
+            || (addr = mmap(0, len, PROT_READ | PROT_WRITE, MAP_SHARED,
+                    fd, 0)) == MAP_FAILED)
+    {
+        close(fd);
+        addr = 0;
+        goto done;
+    }
+
+    struct mapping *m = xmalloc(sizeof *m);
+    m->next = mappings;
+    m->addr = addr;
+    m->len = len;
+    m->fd = fd;
+    mappings = m;
+
+done:
+    pthread_mutex_unlock(&storageLock);
+    return addr;
+}
+
+static void *remapFile(struct mapping *m, size_t bytes)
+{
+    size_t len = pageBytes(bytes);
+    if (len != m->len && ftruncate(m->fd, (off_t)len) < 0) return 0;
+    void *addr = mmap(0, len, PROT_READ | PROT_WRITE, MAP_SHARED, m->fd, 0);
+    if (addr == MAP_FAILED) return 0;
+    munmap(m->addr, m->len);
+    m->addr = addr;
+    m->len = len;
+    return addr;
+}
+
+static void unmap(struct mapping **m)
+{
+    struct mapping *dead = *m;
+    *m = dead->next;
+    munmap(dead->addr, dead->len);
+    close(dead->fd);
+    free(dead);
+}
+#else
+static void *mapFile(size_t bytes)
+{
+    (void)bytes;
+    return 0;
+}
+#endif
+
+void hugeint_setStorage(const char *directory, size_t threshold)
+{
+    pthread_mutex_lock(&storageLock);
+    free(storageDirectory);
+    storageDirectory = 0;
+    if (directory)
+    {
+        storageDirectory = xmalloc(strlen(directory) + 1);
+        strcpy(storageDirectory, directory);
+    }
+    atomic_store(&storageThreshold, directory ? threshold : SIZE_MAX);
+    pthread_mutex_unlock(&storageLock);
+}
+
+hugeint *hugeint_alloc(size_t limbs)
+{
+    size_t bytes = limbBytes(limbs);
+    if (bytes >= atomic_load_explicit(&storageThreshold,
+                memory_order_relaxed))
+    {
+        hugeint *self = mapFile(bytes);
+        if (self)
+        {
+            self->mapped = 1;
+            return self;
+        }
+    }
+    hugeint *self = xmalloc(bytes);
+    self->mapped = 0;
+    return self;
+}
+
+hugeint *hugeint_realloc(hugeint *self, size_t limbs)
+{
+    size_t bytes = limbBytes(limbs);
+    size_t threshold = atomic_load_explicit(&storageThreshold,
+            memory_order_relaxed);
+
+#ifdef HUGEINT_HAVE_MMAP
+    if (self->mapped)
+    {
+        pthread_mutex_lock(&storageLock);
+        struct mapping **m = findMapping(self);
+        void *addr = bytes >= threshold ? remapFile(*m, bytes) : 0;
+        if (addr)
+        {
+            pthread_mutex_unlock(&storageLock);
+            return addr;
+        }
+        size_t keep = limbBytes(self->s);
+        hugeint *moved = xmalloc(bytes);
+        memcpy(moved, self, keep < bytes ? keep : bytes);
+        moved->mapped = 0;
+        unmap(m);
+        pthread_mutex_unlock(&storageLock);
+        return moved;
+    }
+#endif
+
+    if (bytes >= threshold)
+    {
+        hugeint *moved = mapFile(bytes);
+        if (moved)
+        {
+            size_t keep = limbBytes(self->s);
+            memcpy(moved, self, keep < bytes ? keep : bytes);
+            moved->mapped = 1;
+            free(self);
+            return moved;
+        }
+    }
+    return xrealloc(self, bytes);
+}
+
+void hugeint_free(hugeint *self)
+{
+#ifdef HUGEINT_HAVE_MMAP
+    if (self && self->mapped)
+    {
+        pthread_mutex_lock(&storageLock);
+        unmap(findMapping(self));
+        pthread_mutex_unlock(&storageLock);
+        return;
+    }
+#endif
+    free(self);
+}
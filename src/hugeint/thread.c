@@ -0,0 +1,58 @@
+#include "internal.h"
+
+static atomic_uint threadCount = 1;
+
+void hugeint_setThreads(unsigned int count)
+{
+    atomic_store(&threadCount, count ? count : 1);
+}
+
+unsigned int hugeint_threads(void)
+{
+    return atomic_load(&threadCount);
+}
+
+void hugeint_spareThreadsInit(atomic_uint *spare)
+{
+    atomic_init(spare, hugeint_threads() - 1);
+}
+
+static void *forkRun(void *arg)
+{
+    struct hugeint_fork *self = arg;
+    hugeint_progressAttach(self->progress);
+    self->run(self->arg);
+    return 0;
+}
+
+int hugeint_forkTry(struct hugeint_fork *self, atomic_uint *spare,
+        void (*run)(void *), void *arg)
+{
+    self->spare = 0;
+    self->run = run;
+    self->arg = arg;
+    if (!spare) return 0;
+    unsigned int available = atomic_load(spare);
+    while (available && !atomic_compare_exchange_weak(spare,
+                &available, available - 1));
+    if (!available) return 0;
+    self->spare = spare;
+    self->progress = hugeint_progressInherit();
+    if (!pthread_create(&self->thread, 0, forkRun, self)) return 1;
+    atomic_fetch_add(spare, 1);
+    self->spare = 0;
+    return 0;
+}
+
+void hugeint_forkStart(struct hugeint_fork *self, atomic_uint *spare,
+        void (*run)(void *), void *arg)
+{
+    if (!hugeint_forkTry(self, spare, run, arg)) run(arg);
+}
+
+void hugeint_forkJoin(struct hugeint_fork *self)
+{
+    if (!self->spare) return;
+    pthread_join(self->thread, 0);
+    atomic_fetch_add(self->spare, 1);
+}
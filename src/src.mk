@@ -1,6 +1,8 @@
 $(call zinc,hugeint/hugeint.mk)
+$(call zinc,batch/batch.mk)
 $(call zinc,divide/divide.mk)
 $(call zinc,factorial/factorial.mk)
+$(call zinc,fibonacci/fibonacci.mk)
 
 $(call zinc,test/test.mk)
 
@@ -1,6 +1,9 @@
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <pocas/test/test.h>
 #include "../hugeint/hugeint.h"
+#include "../hugeint/fixed.h"
 
 PT_TESTCLASS(hugeint);
 
@@ -12,9 +15,9 @@ PT_TESTMETHOD(additionIsCorrect)
     char *sumStr = hugeint_toString(sum);
     PT_Test_assertStrEqual("100000005000000000000002", sumStr, "wrong result");
     free(sumStr);
-    free(sum);
-    free(a);
-    free(b);
+    hugeint_free(sum);
+    hugeint_free(a);
+    hugeint_free(b);
     PT_Test_pass();
 }
 
@@ -26,9 +29,9 @@ PT_TESTMETHOD(subtractionIsCorrect)
     char *diffStr = hugeint_toString(diff);
     PT_Test_assertStrEqual("100000002000000000000000", diffStr, "wrong result");
     free(diffStr);
-    free(diff);
-    free(a);
-    free(b);
+    hugeint_free(diff);
+    hugeint_free(a);
+    hugeint_free(b);
     PT_Test_pass();
 }
 
@@ -40,35 +43,1189 @@ PT_TESTMETHOD(multiplicationIsCorrect)
     char *prodStr = hugeint_toString(product);
     PT_Test_assertStrEqual("51090942171709440000", prodStr, "wrong result");
     free(prodStr);
-    free(product);
-    free(a);
-    free(b);
+    hugeint_free(product);
+    hugeint_free(a);
+    hugeint_free(b);
     a = hugeint_parse("562000363888803840000");
     b = hugeint_fromUint(2);
     product = hugeint_mult(a, b);
     prodStr = hugeint_toString(product);
     PT_Test_assertStrEqual("1124000727777607680000", prodStr, "wrong result");
     free(prodStr);
-    free(product);
-    free(a);
-    free(b);
+    hugeint_free(product);
+    hugeint_free(a);
+    hugeint_free(b);
     a = hugeint_parse("46833363657400320000");
     b = hugeint_fromUint(4);
     product = hugeint_mult(a, b);
     prodStr = hugeint_toString(product);
     PT_Test_assertStrEqual("187333454629601280000", prodStr, "wrong result");
     free(prodStr);
-    free(product);
-    free(a);
-    free(b);
+    hugeint_free(product);
+    hugeint_free(a);
+    hugeint_free(b);
     a = hugeint_parse("83000567673654159270286824042913149749436958055596052501112243788006768842629242159104");
     b = hugeint_fromUint(4);
     product = hugeint_mult(a, b);
     prodStr = hugeint_toString(product);
     PT_Test_assertStrEqual("332002270694616637081147296171652598997747832222384210004448975152027075370516968636416", prodStr, "wrong result");
     free(prodStr);
-    free(product);
-    free(a);
-    free(b);
+    hugeint_free(product);
+    hugeint_free(a);
+    hugeint_free(b);
+    PT_Test_pass();
+}
+
+struct chunkReader
+{
+    const char *str;
+    size_t chunk;
+};
+
+static size_t readChunk(void *ctx, char *buf, size_t size)
+{
+    struct chunkReader *cr = ctx;
+    size_t len = strlen(cr->str);
+    if (len > cr->chunk) len = cr->chunk;
+    if (len > size) len = size;
+    memcpy(buf, cr->str, len);
+    cr->str += len;
+    return len;
+}
+
+PT_TESTMETHOD(readingIsCorrect)
+{
+    struct chunkReader cr = { "  0004356981235609812365098127365"
+        "0981726354091872630598172635091872635\n17", 7 };
+    hugeint *a = hugeint_readDecimalFrom(readChunk, &cr);
+    char *aStr = hugeint_toString(a);
+    PT_Test_assertStrEqual("43569812356098123650981273650981726354091872630598"
+            "172635091872635", aStr, "wrong decimal result");
+    free(aStr);
+    hugeint_free(a);
+    cr.str = "\t00fedcba9876543210123456789abcdefABCDEF1 ";
+    cr.chunk = 5;
+    a = hugeint_readHexFrom(readChunk, &cr);
+    aStr = hugeint_toHexString(a);
+    PT_Test_assertStrEqual("fedcba9876543210123456789abcdefabcdef1", aStr,
+            "wrong hex result");
+    free(aStr);
+    hugeint_free(a);
+    cr.str = " 00 5";
+    cr.chunk = 2;
+    a = hugeint_readDecimalFrom(readChunk, &cr);
+    aStr = hugeint_toString(a);
+    PT_Test_assertStrEqual("0", aStr, "read past the decimal number");
+    free(aStr);
+    hugeint_free(a);
+    cr.str = "\t0 f";
+    a = hugeint_readHexFrom(readChunk, &cr);
+    aStr = hugeint_toHexString(a);
+    PT_Test_assertStrEqual("0", aStr, "read past the hex number");
+    free(aStr);
+    hugeint_free(a);
+    a = hugeint_parse(" 00 5");
+    aStr = hugeint_toString(a);
+    PT_Test_assertStrEqual("0", aStr, "parsed past the number");
+    free(aStr);
+    hugeint_free(a);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(parsingStopsAtTheFirstSeparator)
+{
+    static const struct
+    {
+        const char *str;
+        unsigned int radix;
+        const char *expected;
+    } cases[] = {
+        { " \t 0012", 10, "12" },
+        { "0 5", 10, "0" },
+        { " 00 5", 10, "0" },
+        { "12 34", 10, "12" },
+        { "00\t7", 16, "0" },
+        { "\t0ff 1", 16, "ff" },
+        { "  zz 1", 36, "zz" },
+        { "0 0 5", 36, "0" }
+    };
+    for (size_t i = 0; i < sizeof cases / sizeof *cases; ++i)
+    {
+        hugeint *a = cases[i].radix == 10 ? hugeint_parse(cases[i].str)
+                : hugeint_parseBase(cases[i].str, cases[i].radix);
+        char *aStr = hugeint_toStringBase(a, cases[i].radix);
+        PT_Test_assertStrEqual(cases[i].expected, aStr,
+                "wrong number prefix handling");
+        free(aStr);
+        hugeint_free(a);
+    }
+    PT_Test_pass();
+}
+
+static char *randomHex(size_t len, unsigned int seed)
+{
+    static const char digits[] = "0123456789abcdef";
+    char *str = malloc(len + 1);
+    srand(seed);
+    for (size_t i = 0; i < len; ++i) str[i] = digits[rand() & 0xf];
+    if (str[0] == '0') str[0] = '1';
+    str[len] = 0;
+    return str;
+}
+
+PT_TESTMETHOD(hexRoundTripIsCorrect)
+{
+    hugeint *a = hugeint_parseHex("00000000000000000000000000000000FfE");
+    char *aStr = hugeint_toHexString(a);
+    PT_Test_assertStrEqual("ffe", aStr, "wrong result for leading zeros");
+    free(aStr);
+    hugeint_free(a);
+    for (size_t len = 1; len < 100; ++len)
+    {
+        char *str = randomHex(len, len);
+        a = hugeint_parseHex(str);
+        aStr = hugeint_toHexString(a);
+        PT_Test_assertStrEqual(str, aStr, "round trip failed");
+        free(aStr);
+        hugeint_free(a);
+        free(str);
+    }
+    char *str = randomHex(16 * 1024 * 1024 + 5, 42);
+    a = hugeint_parseHex(str);
+    aStr = hugeint_toHexString(a);
+    PT_Test_assertStrEqual(str, aStr, "round trip of 2^20 limbs failed");
+    free(aStr);
+    hugeint_free(a);
+    free(str);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(radixConversionIsCorrect)
+{
+    hugeint *a = hugeint_parse("1000000000000000000000000000000000000000");
+    char *aStr = hugeint_toStringBase(a, 36);
+    PT_Test_assertStrEqual("18jehaa7xj8vnwz5gou9llfu9s", aStr, "wrong base 36 result");
+    free(aStr);
+    aStr = hugeint_toStringBase(a, 62);
+    PT_Test_assertStrEqual("MtbF9ggu1HhGm7VozeJTcG", aStr, "wrong base 62 result");
+    free(aStr);
+    aStr = hugeint_toStringBase(a, 8);
+    PT_Test_assertStrEqual("13602417722342241654610575452550000000000000",
+            aStr, "wrong base 8 result");
+    free(aStr);
+    hugeint_free(a);
+    a = hugeint_parseBase("  MtbF9ggu1HhGm7VozeJTcG", 62);
+    aStr = hugeint_toString(a);
+    PT_Test_assertStrEqual("1000000000000000000000000000000000000000", aStr,
+            "wrong result parsing base 62");
+    free(aStr);
+    hugeint_free(a);
+    for (unsigned int radix = 2; radix <= 62; ++radix)
+    {
+        char *str = randomHex(3000, radix);
+        a = hugeint_parseHex(str);
+        char *conv = hugeint_toStringBase(a, radix);
+        hugeint *b = hugeint_parseBase(conv, radix);
+        aStr = hugeint_toHexString(b);
+        PT_Test_assertStrEqual(str, aStr, "radix round trip failed");
+        free(aStr);
+        hugeint_free(b);
+        free(conv);
+        hugeint_free(a);
+        free(str);
+    }
+    PT_Test_pass();
+}
+
+static const char *uintStr(hugeint_Uint val)
+{
+    static char buf[64];
+    snprintf(buf, sizeof buf, "%ju", val);
+    return buf;
+}
+
+PT_TESTMETHOD(uintKernelsAreCorrect)
+{
+    hugeint *a = hugeint_parse("340282366920938463463374607431768211455");
+    hugeint *b = hugeint_parse("18446744073709551615");
+    hugeint_multUintToSelf(&a, 1000);
+    char *aStr = hugeint_toString(a);
+    PT_Test_assertStrEqual("340282366920938463463374607431768211455000", aStr,
+            "wrong product");
+    free(aStr);
+    hugeint_addMulUintToSelf(&a, b, 12345);
+    aStr = hugeint_toString(a);
+    PT_Test_assertStrEqual("340282366920938463691099663021712626142175", aStr,
+            "wrong accumulated product");
+    free(aStr);
+    hugeint_subMulUintFromSelf(&a, b, 12345);
+    aStr = hugeint_toString(a);
+    PT_Test_assertStrEqual("340282366920938463463374607431768211455000", aStr,
+            "wrong difference");
+    free(aStr);
+    hugeint_Uint r = hugeint_divUintToSelf(&a, 1001);
+    aStr = hugeint_toString(a);
+    PT_Test_assertStrEqual("339942424496442021441932674757011200254", aStr,
+            "wrong quotient");
+    PT_Test_assertStrEqual("746", uintStr(r), "wrong remainder");
+    free(aStr);
+    hugeint_UintDivisor divisor;
+    hugeint_prepareUintDivisor(&divisor, 3);
+    r = hugeint_divPreparedUintToSelf(&a, &divisor);
+    aStr = hugeint_toString(a);
+    PT_Test_assertStrEqual("113314141498814007147310891585670400084", aStr,
+            "wrong prepared quotient");
+    PT_Test_assertStrEqual("2", uintStr(r), "wrong prepared remainder");
+    free(aStr);
+    PT_Test_assertStrEqual("0", uintStr(hugeint_prepareUintDivisor(&divisor,
+                0)), "zero divisor accepted");
+    PT_Test_assertStrEqual("0", uintStr(hugeint_divPreparedUintToSelf(&a,
+                &divisor)), "division by zero returned a remainder");
+    aStr = hugeint_toString(a);
+    PT_Test_assertStrEqual("113314141498814007147310891585670400084", aStr,
+            "division by zero changed the value");
+    free(aStr);
+    hugeint_subMulUintFromSelf(&a, b, 0xffffffffU);
+    PT_Test_assertStrEqual("ok", a ? "ok" : "null", "unexpected negative result");
+    hugeint_subMulUintFromSelf(&a, a, 2);
+    PT_Test_assertStrEqual("null", a ? "ok" : "null",
+            "negative result not detected");
+    hugeint_free(b);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(arrayOperationsAreCorrect)
+{
+    hugeint *xs[1000];
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        xs[i] = hugeint_parse("340282366920938463463374607431768211455");
+        hugeint_multUintToSelf(&xs[i], i + 1);
+    }
+    hugeint *sum = hugeint_sumArray(1000, xs);
+    char *sumStr = hugeint_toString(sum);
+    PT_Test_assertStrEqual("170311324643929700963418991019599989833227500",
+            sumStr, "wrong sum");
+    free(sumStr);
+    hugeint_free(sum);
+    for (size_t i = 0; i < 1000; ++i) hugeint_free(xs[i]);
+
+    for (size_t i = 0; i < 30; ++i) xs[i] = hugeint_fromUint(i + 1);
+    hugeint *product = hugeint_productArray(30, xs);
+    char *prodStr = hugeint_toString(product);
+    PT_Test_assertStrEqual("265252859812191058636308480000000", prodStr,
+            "wrong product");
+    free(prodStr);
+    hugeint_free(product);
+    for (size_t i = 0; i < 30; ++i) hugeint_free(xs[i]);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(smallValuesAreCorrect)
+{
+    hugeint_small a;
+    hugeint_small b;
+    hugeint_smallInit(&a, 0);
+    hugeint_smallInit(&b, 1);
+    hugeint_smallAddUint(&a, (hugeint_Uint)-1);
+    hugeint_smallIncrement(&a);
+    char *aStr = hugeint_smallToString(&a);
+    PT_Test_assertStrEqual("18446744073709551616", aStr, "wrong increment");
+    free(aStr);
+    PT_Test_assertStrEqual("1", uintStr(hugeint_smallCompare(&a, &b)),
+            "wrong comparison");
+    hugeint *big = hugeint_parse("340282366920938463463374607431768211455");
+    hugeint_small c;
+    hugeint_smallInitFrom(&c, big);
+    hugeint_free(big);
+    hugeint_smallAdd(&c, &b);
+    aStr = hugeint_smallToString(&c);
+    PT_Test_assertStrEqual("340282366920938463463374607431768211456", aStr,
+            "wrong sum after spilling");
+    free(aStr);
+    hugeint_smallAdd(&a, &c);
+    aStr = hugeint_smallToString(&a);
+    PT_Test_assertStrEqual("340282366920938463481821351505477763072", aStr,
+            "wrong sum of spilled value");
+    free(aStr);
+    PT_Test_assertStrEqual("1", uintStr(hugeint_smallCompare(&a, &c)),
+            "wrong comparison of spilled values");
+    hugeint_smallDone(&a);
+    hugeint_smallDone(&b);
+    hugeint_smallDone(&c);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(sharedValuesCopyOnWrite)
+{
+    hugeint_ref *a = hugeint_refCreate(
+            hugeint_parse("123456789012345678901234567890"));
+    hugeint_ref *b = hugeint_refClone(a);
+    PT_Test_assertStrEqual("shared", hugeint_refValue(a) == hugeint_refValue(b)
+            ? "shared" : "copied", "clone copied the value");
+    hugeint_shiftLeft(hugeint_refMutable(&b), 64);
+    char *aStr = hugeint_toString(hugeint_refValue(a));
+    char *bStr = hugeint_toString(hugeint_refValue(b));
+    PT_Test_assertStrEqual("123456789012345678901234567890", aStr,
+            "shared value was modified");
+    PT_Test_assertStrEqual("2277375791072698140248390838022561708011411210240",
+            bStr, "wrong shifted value");
+    free(aStr);
+    free(bStr);
+    const hugeint *before = hugeint_refValue(a);
+    hugeint_increment(hugeint_refMutable(&a));
+    PT_Test_assertStrEqual("in place", hugeint_refValue(a) == before
+            ? "in place" : "copied", "unshared value was copied");
+    hugeint *value = hugeint_refRelease(a);
+    aStr = hugeint_toString(value);
+    PT_Test_assertStrEqual("123456789012345678901234567891", aStr,
+            "wrong released value");
+    free(aStr);
+    hugeint_free(value);
+    hugeint_refFree(b);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(shiftedAdditionIsCorrect)
+{
+    hugeint *a = hugeint_parseHex("ffffffffffffffffffffffffffffffff");
+    hugeint *b = hugeint_parseHex("1");
+    hugeint_addShiftedToSelf(&a, b, 1);
+    char *aStr = hugeint_toHexString(a);
+    PT_Test_assertStrEqual("1" "0000000000000000" "ffffffffffffffff", aStr,
+            "wrong limb-shifted sum");
+    free(aStr);
+    hugeint_addShiftedToSelf(&b, a, 3);
+    aStr = hugeint_toHexString(b);
+    PT_Test_assertStrEqual("1" "0000000000000000" "ffffffffffffffff"
+            "0000000000000000" "0000000000000000" "0000000000000001", aStr,
+            "wrong sum beyond the end");
+    free(aStr);
+    hugeint_addShiftedBitsToSelf(&a, a, 4);
+    aStr = hugeint_toHexString(a);
+    PT_Test_assertStrEqual("11" "0000000000000010" "ffffffffffffffef", aStr,
+            "wrong bit-shifted sum");
+    free(aStr);
+    hugeint_free(a);
+    hugeint_free(b);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(unbalancedMultiplicationIsCorrect)
+{
+    char *x = malloc(20001);
+    char *y = malloc(1201);
+    char *expected = malloc(21201);
+    memset(x, 'f', 20000);
+    x[20000] = 0;
+    memset(y, 'f', 1200);
+    y[1200] = 0;
+    memset(expected, 'f', 20000);
+    expected[1199] = 'e';
+    memset(expected + 20000, '0', 1199);
+    expected[21199] = '1';
+    expected[21200] = 0;
+
+    hugeint *a = hugeint_parseHex(x);
+    hugeint *b = hugeint_parseHex(y);
+    hugeint *p = hugeint_mult(a, b);
+    char *pStr = hugeint_toHexString(p);
+    PT_Test_assertStrEqual(expected, pStr, "wrong unbalanced product");
+    free(pStr);
+    hugeint_free(p);
+    p = hugeint_mult(b, a);
+    pStr = hugeint_toHexString(p);
+    PT_Test_assertStrEqual(expected, pStr, "wrong swapped unbalanced product");
+    free(pStr);
+    hugeint_free(p);
+    hugeint_free(a);
+    hugeint_free(b);
+    free(x);
+    free(y);
+    free(expected);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(exactDivisionIsCorrect)
+{
+    char *x = randomHex(3000, 7);
+    char *y = randomHex(1000, 8);
+    hugeint *a = hugeint_parseHex(x);
+    hugeint *b = hugeint_parseHex(y);
+    hugeint_shiftLeft(&b, 67);
+    hugeint *p = hugeint_mult(a, b);
+    hugeint *q = hugeint_divExact(p, b);
+    char *qStr = hugeint_toHexString(q);
+    PT_Test_assertStrEqual(x, qStr, "wrong exact quotient");
+    free(qStr);
+    hugeint_free(q);
+    q = hugeint_divExact(p, a);
+    hugeint_shiftRight(&q, 67);
+    qStr = hugeint_toHexString(q);
+    PT_Test_assertStrEqual(y, qStr, "wrong long exact quotient");
+    free(qStr);
+    hugeint_free(q);
+
+    hugeint_multUintToSelf(&a, 0xfffffffffffffffaU);
+    hugeint_divExactUintToSelf(&a, 0xfffffffffffffffaU);
+    qStr = hugeint_toHexString(a);
+    PT_Test_assertStrEqual(x, qStr, "wrong single-limb exact quotient");
+    free(qStr);
+    hugeint_free(p);
+    hugeint_free(a);
+    hugeint_free(b);
+    free(x);
+    free(y);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(powersAndCombinatoricsAreCorrect)
+{
+    hugeint *x = hugeint_powUint(3, 100);
+    char *xStr = hugeint_toString(x);
+    PT_Test_assertStrEqual("515377520732011331036461129765621272702107522001",
+            xStr, "wrong power");
+    free(xStr);
+    hugeint *y = hugeint_pow(x, 0);
+    xStr = hugeint_toString(y);
+    PT_Test_assertStrEqual("1", xStr, "wrong zeroth power");
+    free(xStr);
+    hugeint_free(y);
+    hugeint_shiftLeft(&x, 3);
+    y = hugeint_pow(x, 3);
+    hugeint *z = hugeint_powUint(3, 300);
+    hugeint_shiftLeft(&z, 9);
+    PT_Test_assertStrEqual("0", uintStr(hugeint_compare(y, z)),
+            "wrong power of a large base");
+    hugeint_free(x);
+    hugeint_free(y);
+    hugeint_free(z);
+
+    x = hugeint_binomial(100, 50);
+    xStr = hugeint_toString(x);
+    PT_Test_assertStrEqual("100891344545564193334812497256", xStr,
+            "wrong binomial coefficient");
+    free(xStr);
+    hugeint_free(x);
+    x = hugeint_binomial(5, 7);
+    xStr = hugeint_toString(x);
+    PT_Test_assertStrEqual("0", xStr, "wrong binomial for k > n");
+    free(xStr);
+    hugeint_free(x);
+    const struct
+    {
+        hugeint_Uint n;
+        hugeint_Uint k;
+        const char *expected;
+    } binomials[] = {
+        { UINTMAX_MAX, 1, "18446744073709551615" },
+        { UINTMAX_MAX, UINTMAX_MAX - 2,
+            "170141183460469231704017187605319778305" },
+        { UINTMAX_MAX, 3, "1046183622564446793632349203613672605920836997447"
+            "371718655" },
+        { 10000000000U, 2, "49999999995000000000" },
+        { 300000000U, 5, "20249999325000007874999962500000060000000" },
+        { 1000, 30, "2429608192173745103270389838576750719302222606198631438"
+            "800" }
+    };
+    for (size_t i = 0; i < sizeof binomials / sizeof *binomials; ++i)
+    {
+        hugeint *b = hugeint_binomial(binomials[i].n, binomials[i].k);
+        xStr = hugeint_toString(b);
+        PT_Test_assertStrEqual(binomials[i].expected, xStr,
+                "wrong binomial for large n");
+        free(xStr);
+        hugeint_free(b);
+    }
+    x = hugeint_primorial(100);
+    xStr = hugeint_toString(x);
+    PT_Test_assertStrEqual("2305567963945518424753102147331756070", xStr,
+            "wrong primorial");
+    free(xStr);
+    hugeint_free(x);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(fibonacciNumbersAreCorrect)
+{
+    hugeint *x = hugeint_fib(300);
+    char *xStr = hugeint_toString(x);
+    PT_Test_assertStrEqual("2222322446294204455297398934619099672066669390964997"
+            "64990979600", xStr, "wrong Fibonacci number");
+    free(xStr);
+    hugeint_free(x);
+    x = hugeint_lucas(300);
+    xStr = hugeint_toString(x);
+    PT_Test_assertStrEqual("4969264057837466763937914368824682308980674895220346"
+            "99520200002", xStr, "wrong Lucas number");
+    free(xStr);
+    hugeint_free(x);
+    x = hugeint_fib(0);
+    xStr = hugeint_toString(x);
+    PT_Test_assertStrEqual("0", xStr, "wrong F(0)");
+    free(xStr);
+    hugeint_free(x);
+    x = hugeint_lucas(1);
+    xStr = hugeint_toString(x);
+    PT_Test_assertStrEqual("1", xStr, "wrong L(1)");
+    free(xStr);
+    hugeint_free(x);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(parallelConversionIsCorrect)
+{
+    char *x = randomHex(80000, 9);
+    hugeint *a = hugeint_parseHex(x);
+    char *serial = hugeint_toString(a);
+    hugeint_setThreads(4);
+    char *parallel = hugeint_toString(a);
+    hugeint *b = hugeint_parse(serial);
+    hugeint_setThreads(1);
+    PT_Test_assertStrEqual(serial, parallel, "wrong parallel conversion");
+    char *bStr = hugeint_toHexString(b);
+    PT_Test_assertStrEqual(x, bStr, "wrong parallel parse");
+    free(bStr);
+    free(parallel);
+    free(serial);
+    hugeint_free(a);
+    hugeint_free(b);
+    free(x);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(bitOperationsAreCorrect)
+{
+    hugeint *a = hugeint_parseHex("f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0ff");
+    hugeint *b = hugeint_parseHex("123456789abcdef0f");
+    hugeint *r = hugeint_and(a, b);
+    char *rStr = hugeint_toHexString(r);
+    PT_Test_assertStrEqual("20406080a0c0e00f", rStr, "wrong and");
+    free(rStr);
+    hugeint_free(r);
+    r = hugeint_or(a, b);
+    rStr = hugeint_toHexString(r);
+    PT_Test_assertStrEqual("f0f0f0f0f0f0f0f0f1f3f5f7f9fbfdffff", rStr,
+            "wrong or");
+    free(rStr);
+    hugeint_free(r);
+    r = hugeint_xor(a, b);
+    rStr = hugeint_toHexString(r);
+    PT_Test_assertStrEqual("f0f0f0f0f0f0f0f0f1d3b597795b3d1ff0", rStr,
+            "wrong xor");
+    free(rStr);
+    hugeint_free(r);
+    r = hugeint_clone(a);
+    hugeint_andnotToSelf(&r, b);
+    rStr = hugeint_toHexString(r);
+    PT_Test_assertStrEqual("f0f0f0f0f0f0f0f0f0d0b09070503010f0", rStr,
+            "wrong in-place andnot");
+    free(rStr);
+    hugeint_xorToSelf(&r, r);
+    PT_Test_assertStrEqual("0", uintStr(hugeint_isZero(r) ? 0 : 1),
+            "wrong self xor");
+    hugeint_free(r);
+
+    PT_Test_assertStrEqual("72", uintStr(hugeint_popcount(a)),
+            "wrong popcount");
+    PT_Test_assertStrEqual("136", uintStr(hugeint_bitLength(a)),
+            "wrong bit length");
+    PT_Test_assertStrEqual("1", uintStr(hugeint_testBit(a, 135)),
+            "wrong set bit test");
+    PT_Test_assertStrEqual("0", uintStr(hugeint_testBit(a, 136)),
+            "wrong clear bit test");
+    hugeint_shiftLeft(&b, 70);
+    PT_Test_assertStrEqual("70", uintStr(hugeint_scanLowestSet(b)),
+            "wrong lowest set bit");
+    r = hugeint_create();
+    PT_Test_assertStrEqual("1", uintStr(hugeint_scanLowestSet(r) == SIZE_MAX),
+            "wrong lowest set bit of zero");
+    hugeint_free(r);
+    hugeint_shiftRight(&b, 70);
+    hugeint_setBit(&b, 200);
+    rStr = hugeint_toHexString(b);
+    PT_Test_assertStrEqual("1000000000000000000000000000000000123456789abcdef0f",
+            rStr, "wrong setBit");
+    free(rStr);
+    hugeint_free(a);
+    hugeint_free(b);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(capacityManagementKeepsValues)
+{
+    hugeint *a = hugeint_parseHex("123456789abcdef0123456789abcdef");
+    hugeint_reserve(&a, 1000);
+    hugeint_shiftLeft(&a, 64 * 900);
+    hugeint_shiftRight(&a, 64 * 900);
+    hugeint_shrinkToFit(&a);
+    hugeint *b = hugeint_clone(a);
+    hugeint_setGrowthPercent(100);
+    hugeint_increment(&b);
+    hugeint_shiftLeft(&b, 4);
+    hugeint_setGrowthPercent(200);
+    char *aStr = hugeint_toHexString(a);
+    char *bStr = hugeint_toHexString(b);
+    PT_Test_assertStrEqual("123456789abcdef0123456789abcdef", aStr,
+            "wrong value after shrinking");
+    PT_Test_assertStrEqual("123456789abcdef0123456789abcdf00", bStr,
+            "wrong value after exact growth");
+    free(aStr);
+    free(bStr);
+    hugeint_free(a);
+    hugeint_free(b);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(fixedWidthArithmeticIsCorrect)
+{
+    hugeint *a = hugeint_parseHex("ffffffffffffffffffffffffffffffff"
+            "0123456789abcdef");
+    hugeint *b = hugeint_parseHex("fedcba98765432100000000000000001");
+    hugeint256 x;
+    hugeint256 y;
+    hugeint256 r;
+    hugeint256 s;
+    hugeint256_fromHugeint(&x, a);
+    hugeint256_fromHugeint(&y, b);
+
+    hugeint256_mulWide(&s, &r, &x, &y);
+    hugeint *t = hugeint256_toHugeint(&r);
+    char *tStr = hugeint_toHexString(t);
+    PT_Test_assertStrEqual("2453f683723a5322236d88fe5618cef0123456789abcdef",
+            tStr, "wrong low product");
+    free(tStr);
+    hugeint_free(t);
+    t = hugeint256_toHugeint(&s);
+    tStr = hugeint_toHexString(t);
+    PT_Test_assertStrEqual("fedcba9876543210", tStr, "wrong high product");
+    free(tStr);
+    hugeint_free(t);
+
+    PT_Test_assertStrEqual("1", uintStr(hugeint256_divrem(&r, &s, &x, &y)),
+            "division failed");
+    t = hugeint256_toHugeint(&r);
+    tStr = hugeint_toHexString(t);
+    PT_Test_assertStrEqual("10124924924924924", tStr, "wrong quotient");
+    free(tStr);
+    hugeint_free(t);
+    t = hugeint256_toHugeint(&s);
+    tStr = hugeint_toHexString(t);
+    PT_Test_assertStrEqual("7f598f328cc265bdfffeb31e651984cb", tStr,
+            "wrong remainder");
+    free(tStr);
+    hugeint_free(t);
+
+    hugeint256_fromUint(&y, 0);
+    hugeint256_sub(&y, &y, &x);
+    hugeint256_fromUint(&r, 5);
+    hugeint256_add(&r, &r, &x);
+    PT_Test_assertStrEqual("1", uintStr(hugeint256_add(&r, &r, &y)),
+            "missing carry");
+    hugeint256_shiftLeft(&s, &x, 100);
+    t = hugeint256_toHugeint(&s);
+    tStr = hugeint_toHexString(t);
+    PT_Test_assertStrEqual("fffffffffffffffffffffff0123456789abcdef"
+            "0000000000000000000000000", tStr, "wrong shift");
+    free(tStr);
+    hugeint_free(t);
+    hugeint256_fromUint(&y, 0);
+    PT_Test_assertStrEqual("0", uintStr(hugeint256_divrem(&r, &s, &x, &y)),
+            "division by zero accepted");
+    hugeint_free(a);
+    hugeint_free(b);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(longDivisionEdgeCasesAreCorrect)
+{
+    static const struct
+    {
+        const char *dividend;
+        const char *divisor;
+        const char *quotient;
+        const char *remainder;
+    } cases[] = {
+        { "7ffffffffffffffffffffffffffffffe"
+            "00000000000000028000000000000000",
+            "fffffffffffffffe00000000000000007fffffffffffffff",
+            "8000000000000000",
+            "fffffffffffffffdc0000000000000030000000000000000" },
+        { "ffffffffffffffff8000000000000001"
+            "0000000100000000ffffffffffffffff",
+            "800000000000000080000000000000018000000000000001",
+            "1fffffffffffffffc",
+            "800000000000000000000001000000050000000000000003" },
+        { "123456789abcdef0fedcba9876543210"
+            "ffffffffffffffff0000000000000001",
+            "10000000000000000",
+            "123456789abcdef0fedcba9876543210ffffffffffffffff", "1" },
+        { "ffffffffffffffffffffffffffffffffffffffffffffffff",
+            "ffffffffffffffffffffffffffffffff",
+            "10000000000000000", "ffffffffffffffff" },
+        { "fedcba9876543210fedcba9876543210fedcba9876543210",
+            "ffffffffffffffff",
+            "fedcba9876543211fdb97530eca86422", "fc962fc962fc9632" },
+        { "fedcba9876543210fedcba98765432100000000000000000",
+            "1fedcba9876543210fedcba9876543210",
+            "7fb70521a3a27e93", "bc0994206285df633c528efebee360d0" },
+        { "fedcba9876543210fedcba9876543210",
+            "fedcba9876543210fedcba9876543211",
+            "0", "fedcba9876543210fedcba9876543210" },
+        { "fedcba9876543210fedcba9876543210",
+            "fedcba9876543210fedcba9876543210",
+            "1", "0" }
+    };
+    for (size_t i = 0; i < sizeof cases / sizeof *cases; ++i)
+    {
+        hugeint *a = hugeint_parseHex(cases[i].dividend);
+        hugeint *b = hugeint_parseHex(cases[i].divisor);
+        hugeint *r;
+        hugeint *q = hugeint_div(a, b, &r);
+        char *qStr = hugeint_toHexString(q);
+        char *rStr = hugeint_toHexString(r);
+        PT_Test_assertStrEqual(cases[i].quotient, qStr, "wrong quotient");
+        PT_Test_assertStrEqual(cases[i].remainder, rStr, "wrong remainder");
+        free(qStr);
+        free(rStr);
+        hugeint_free(q);
+        hugeint_free(r);
+        hugeint_free(a);
+        hugeint_free(b);
+    }
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(residueArithmeticIsCorrect)
+{
+    char *x = randomHex(500, 11);
+    char *y = randomHex(500, 12);
+    hugeint *a = hugeint_parseHex(x);
+    hugeint *b = hugeint_parseHex(y);
+    hugeint *expected = hugeint_mult(a, b);
+    hugeint_addToSelf(&expected, a);
+    hugeint_subFromSelf(&expected, b);
+
+    hugeint_rns *rns = hugeint_rnsCreate(4096);
+    size_t n = hugeint_rnsSize(rns);
+    hugeint_Uint *ra = malloc(n * sizeof *ra);
+    hugeint_Uint *rb = malloc(n * sizeof *rb);
+    hugeint_Uint *rc = malloc(n * sizeof *rc);
+    hugeint_rnsFromHugeint(rns, ra, a);
+    hugeint_rnsFromHugeint(rns, rb, b);
+    hugeint_rnsMul(rns, rc, ra, rb);
+    hugeint_rnsAdd(rns, rc, rc, ra);
+    hugeint_rnsSub(rns, rc, rc, rb);
+    hugeint *c = hugeint_rnsToHugeint(rns, rc);
+
+    char *cStr = hugeint_toHexString(c);
+    char *eStr = hugeint_toHexString(expected);
+    PT_Test_assertStrEqual(eStr, cStr, "wrong residue arithmetic");
+    free(cStr);
+    free(eStr);
+    hugeint_free(c);
+    free(ra);
+    free(rb);
+    free(rc);
+    hugeint_rnsFree(rns);
+    hugeint_free(expected);
+    hugeint_free(a);
+    hugeint_free(b);
+    free(x);
+    free(y);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(fileBackedValuesAreCorrect)
+{
+    hugeint *a = hugeint_fib(50000);
+    hugeint *b = hugeint_mult(a, a);
+    char *expected = hugeint_toHexString(b);
+    hugeint_free(b);
+
+    hugeint_setStorage("/tmp", 0);
+    b = hugeint_fib(50000);
+    hugeint *c = hugeint_mult(b, b);
+    hugeint_shiftLeft(&c, 64 * 1000);
+    hugeint_shiftRight(&c, 64 * 1000);
+    hugeint_shrinkToFit(&c);
+    char *cStr = hugeint_toHexString(c);
+    PT_Test_assertStrEqual(expected, cStr, "wrong file-backed result");
+    free(cStr);
+
+    hugeint_setStorage("/tmp", SIZE_MAX);
+    hugeint_shiftLeft(&c, 64 * 1000);
+    hugeint_shiftRight(&c, 64 * 1000);
+    cStr = hugeint_toHexString(c);
+    PT_Test_assertStrEqual(expected, cStr, "wrong result after leaving file");
+    free(cStr);
+    hugeint_free(b);
+    hugeint_free(c);
+
+    hugeint_setStorage("/nonexistent/hugeint", 0);
+    b = hugeint_fib(50000);
+    c = hugeint_mult(b, b);
+    cStr = hugeint_toHexString(c);
+    PT_Test_assertStrEqual(expected, cStr, "wrong heap fallback result");
+    free(cStr);
+    hugeint_free(b);
+    hugeint_free(c);
+    hugeint_setStorage(0, 0);
+
+    free(expected);
+    hugeint_free(a);
+    PT_Test_pass();
+}
+
+static int countProgress(void *ctx, size_t done, size_t remaining)
+{
+    (void)done;
+    (void)remaining;
+    ++*(size_t *)ctx;
+    return 0;
+}
+
+static int abortProgress(void *ctx, size_t done, size_t remaining)
+{
+    (void)ctx;
+    (void)done;
+    (void)remaining;
+    return 1;
+}
+
+PT_TESTMETHOD(progressCallbackCanAbort)
+{
+    char *x = randomHex(40000, 31);
+    char *y = randomHex(30000, 37);
+    hugeint *a = hugeint_parseHex(x);
+    hugeint *b = hugeint_parseHex(y);
+    hugeint *p = hugeint_mult(a, b);
+    char *expected = hugeint_toString(p);
+
+    size_t calls = 0;
+    hugeint_setProgressCallback(countProgress, &calls, 1000);
+    hugeint *q = hugeint_mult(a, b);
+    char *qStr = hugeint_toString(q);
+    PT_Test_assertStrEqual(expected, qStr, "wrong result with progress");
+    PT_Test_assertStrEqual("reported", calls ? "reported" : "silent",
+            "no progress reported");
+    free(qStr);
+    hugeint_free(q);
+
+    hugeint_setProgressCallback(abortProgress, 0, 1000);
+    hugeint *r;
+    PT_Test_assertStrEqual("aborted", hugeint_mult(a, b) ? "completed"
+            : "aborted", "multiplication not aborted");
+    PT_Test_assertStrEqual("aborted", hugeint_div(p, b, &r) ? "completed"
+            : "aborted", "division not aborted");
+    PT_Test_assertStrEqual("aborted", hugeint_toString(p) ? "completed"
+            : "aborted", "conversion not aborted");
+    PT_Test_assertStrEqual("aborted", hugeint_fib(200000) ? "completed"
+            : "aborted", "fibonacci not aborted");
+    hugeint_rns *rns = hugeint_rnsCreate(hugeint_bitLength(p));
+    hugeint_Uint *residues = malloc(hugeint_rnsSize(rns) * sizeof *residues);
+    PT_Test_assertStrEqual("aborted", hugeint_rnsFromHugeint(rns, residues, p)
+            ? "aborted" : "completed", "residue reduction not aborted");
+    hugeint_setProgressCallback(0, 0, 0);
+    PT_Test_assertStrEqual("completed", hugeint_rnsFromHugeint(rns, residues,
+            p) ? "aborted" : "completed", "residue reduction failed");
+    free(residues);
+    hugeint_rnsFree(rns);
+
+    q = hugeint_mult(a, b);
+    qStr = hugeint_toString(q);
+    PT_Test_assertStrEqual(expected, qStr, "wrong result after abort");
+    free(qStr);
+    hugeint_free(q);
+    free(expected);
+    hugeint_free(p);
+    hugeint_free(a);
+    hugeint_free(b);
+    free(x);
+    free(y);
+    PT_Test_pass();
+}
+
+static int trackProgress(void *ctx, size_t done, size_t remaining)
+{
+    size_t *last = ctx;
+    if (done < last[0] || done + remaining != 300) last[1] = 1;
+    last[0] = done;
+    return 0;
+}
+
+PT_TESTMETHOD(progressScopesSpanOperations)
+{
+    char *x = randomHex(40000, 59);
+    hugeint *a = hugeint_parseHex(x);
+
+    size_t last[2] = { 0, 0 };
+    hugeint_setProgressCallback(trackProgress, last, 1000);
+    hugeint_progressBegin(300);
+    hugeint_progressStep(50);
+    hugeint *p = hugeint_mult(a, a);
+    hugeint_progressStep(100);
+    hugeint *q = hugeint_mult(p, a);
+    hugeint_progressStep(150);
+    char *qStr = hugeint_toString(p);
+    PT_Test_assertStrEqual("0", uintStr(hugeint_progressEnd()),
+            "scope reported an abort");
+    PT_Test_assertStrEqual("0", uintStr(last[1]), "progress went backwards");
+    PT_Test_assertStrEqual("300", uintStr(last[0]), "scope not completed");
+    free(qStr);
+    hugeint_free(q);
+
+    hugeint_setProgressCallback(abortProgress, 0, 1000);
+    hugeint_progressBegin(2);
+    PT_Test_assertStrEqual("1", uintStr(hugeint_progressStep(1)),
+            "step did not report the abort");
+    PT_Test_assertStrEqual("aborted", hugeint_mult(a, a) ? "completed"
+            : "aborted", "multiplication in scope not aborted");
+    PT_Test_assertStrEqual("aborted", hugeint_mult(p, a) ? "completed"
+            : "aborted", "scope did not stay aborted");
+    PT_Test_assertStrEqual("1", uintStr(hugeint_progressEnd()),
+            "scope abort not reported");
+    hugeint_setProgressCallback(0, 0, 0);
+
+    hugeint_free(p);
+    hugeint_free(a);
+    free(x);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(lazyExpressionsAreCorrect)
+{
+    char *x = randomHex(30000, 41);
+    char *y = randomHex(20000, 43);
+    hugeint *a = hugeint_parseHex(x);
+    hugeint *b = hugeint_parseHex(y);
+    hugeint *ab = hugeint_mult(a, b);
+    hugeint *sum = hugeint_add(ab, a);
+    hugeint_addUintToSelf(&sum, 7);
+    hugeint *diff = hugeint_sub(ab, b);
+    hugeint *expected = hugeint_mult(sum, diff);
+    hugeint *tmp = hugeint_mult(expected, a);
+    hugeint_free(expected);
+    expected = hugeint_div(tmp, b, 0);
+    hugeint_free(tmp);
+
+    hugeint_setThreads(4);
+    hugeint_expr *ea = hugeint_exprValue(a);
+    hugeint_expr *eab = hugeint_exprMult(hugeint_exprClone(ea),
+            hugeint_exprValue(b));
+    hugeint_expr *esum = hugeint_exprAdd(hugeint_exprAdd(
+                hugeint_exprClone(eab), hugeint_exprClone(ea)),
+            hugeint_exprUint(7));
+    hugeint_expr *ediff = hugeint_exprSub(eab, hugeint_exprValue(b));
+    hugeint_expr *e = hugeint_exprDiv(hugeint_exprMult(hugeint_exprMult(
+                    esum, ediff), ea), hugeint_exprValue(b));
+    hugeint *c = hugeint_exprEval(e);
+    hugeint *d = hugeint_exprEval(e);
+    hugeint_exprFree(e);
+    hugeint_setThreads(1);
+
+    char *cStr = hugeint_toHexString(c);
+    char *dStr = hugeint_toHexString(d);
+    char *eStr = hugeint_toHexString(expected);
+    PT_Test_assertStrEqual(eStr, cStr, "wrong lazy result");
+    PT_Test_assertStrEqual(eStr, dStr, "wrong repeated lazy result");
+    free(cStr);
+    free(dStr);
+    free(eStr);
+    hugeint_free(c);
+    hugeint_free(d);
+    hugeint_free(expected);
+    hugeint_free(diff);
+    hugeint_free(sum);
+    hugeint_free(ab);
+    hugeint_free(a);
+    hugeint_free(b);
+    free(x);
+    free(y);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(longExpressionChainsAreCorrect)
+{
+    hugeint *three = hugeint_fromUint(3);
+    hugeint_expr *term = hugeint_exprValue(three);
+    hugeint_expr *total = hugeint_exprClone(term);
+    for (size_t i = 1; i < 1000000; ++i)
+    {
+        total = hugeint_exprAdd(total, hugeint_exprClone(term));
+    }
+    hugeint *result = hugeint_exprEval(total);
+    char *resultStr = hugeint_toString(result);
+    PT_Test_assertStrEqual("3000000", resultStr, "wrong long running sum");
+    free(resultStr);
+    hugeint_free(result);
+    hugeint_exprFree(total);
+
+    hugeint *million = hugeint_fromUint(1000000);
+    total = hugeint_exprValue(million);
+    for (size_t i = 0; i < 100000; ++i)
+    {
+        total = hugeint_exprSub(total, hugeint_exprClone(term));
+    }
+    result = hugeint_exprEval(total);
+    resultStr = hugeint_toString(result);
+    PT_Test_assertStrEqual("700000", resultStr, "wrong long difference");
+    free(resultStr);
+    hugeint_free(result);
+    hugeint_exprFree(total);
+
+    hugeint_expr *one = hugeint_exprUint(1);
+    total = hugeint_exprValue(million);
+    for (size_t i = 0; i < 50000; ++i)
+    {
+        total = hugeint_exprMult(total, hugeint_exprClone(one));
+        total = hugeint_exprAdd(total, hugeint_exprClone(term));
+    }
+    result = hugeint_exprEval(total);
+    resultStr = hugeint_toString(result);
+    PT_Test_assertStrEqual("1150000", resultStr, "wrong long Horner chain");
+    free(resultStr);
+    hugeint_free(result);
+    hugeint_exprFree(total);
+    hugeint_exprFree(one);
+    hugeint_exprFree(term);
+    hugeint_free(million);
+    hugeint_free(three);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(probablePrimesAreDetected)
+{
+    hugeint *m61 = hugeint_powUint(2, 61);
+    hugeint_decrement(&m61);
+    hugeint *m127 = hugeint_powUint(2, 127);
+    hugeint_decrement(&m127);
+    hugeint *m521 = hugeint_powUint(2, 521);
+    hugeint_decrement(&m521);
+    hugeint *f7 = hugeint_powUint(2, 128);
+    hugeint_increment(&f7);
+    hugeint *semi = hugeint_mult(m127, m521);
+    hugeint *odd = hugeint_mult(m127, m61);
+    hugeint_addUintToSelf(&odd, 2);
+    hugeint *xs[] = {
+        hugeint_fromUint(1), hugeint_fromUint(2), hugeint_fromUint(561),
+        m61, m127, m521, f7, semi, odd
+    };
+    size_t n = sizeof xs / sizeof *xs;
+
+    char single[sizeof xs / sizeof *xs + 1] = { 0 };
+    for (size_t i = 0; i < n; ++i)
+    {
+        single[i] = '0' + hugeint_isProbablePrime(xs[i], 8);
+    }
+    PT_Test_assertStrEqual("010111000", single, "wrong primality result");
+
+    int results[sizeof xs / sizeof *xs];
+    char batch[sizeof xs / sizeof *xs + 1] = { 0 };
+    hugeint_setThreads(4);
+    hugeint_isProbablePrimeArray(n, xs, 8, results);
+    hugeint_setThreads(1);
+    for (size_t i = 0; i < n; ++i)
+    {
+        batch[i] = '0' + results[i];
+        hugeint_free(xs[i]);
+    }
+    PT_Test_assertStrEqual(single, batch, "wrong batch primality result");
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(sizeEstimatesAreCorrect)
+{
+    for (size_t len = 1; len < 3000; len = len * 3 + 1)
+    {
+        char *x = randomHex(len, (unsigned int)len);
+        hugeint *a = hugeint_parseHex(x);
+        char *expected = hugeint_toString(a);
+        PT_Test_assertStrEqual("1", uintStr(strlen(expected)
+                    <= hugeint_decimalDigitsUpperBound(a)),
+                "decimal bound too small");
+        char *buf = malloc(hugeint_decimalDigitsUpperBound(a) + 1);
+        PT_Test_assertStrEqual("1", uintStr(hugeint_toStringInto(a, buf)
+                    == strlen(expected)), "wrong length");
+        PT_Test_assertStrEqual(expected, buf, "wrong decimal string");
+        free(buf);
+        free(expected);
+
+        expected = hugeint_toHexString(a);
+        PT_Test_assertStrEqual("1", uintStr(hugeint_hexDigits(a)
+                    == strlen(expected)), "wrong hex digit count");
+        buf = malloc(hugeint_hexDigits(a) + 1);
+        hugeint_toHexStringInto(a, buf);
+        PT_Test_assertStrEqual(expected, buf, "wrong hex string");
+        free(buf);
+        free(expected);
+        hugeint_free(a);
+        free(x);
+    }
+
+    hugeint *p = hugeint_powUint(2, 1000);
+    PT_Test_assertStrEqual("1000", uintStr((uintmax_t)hugeint_log2(p)),
+            "wrong log2");
+    hugeint_shiftRight(&p, 900);
+    hugeint_increment(&p);
+    PT_Test_assertStrEqual("1", uintStr(hugeint_toDouble(p) == 0x1p100),
+            "wrong double");
+    hugeint_free(p);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(hashingAndEqualityAreConsistent)
+{
+    for (size_t len = 1; len < 2000; len = len * 2 + 3)
+    {
+        char *x = randomHex(len, (unsigned int)len + 7);
+        hugeint *a = hugeint_parseHex(x);
+        char *decimal = hugeint_toString(a);
+        hugeint *b = hugeint_parse(decimal);
+        hugeint *c = hugeint_clone(a);
+        hugeint_increment(&c);
+
+        PT_Test_assertStrEqual("1", uintStr(hugeint_equal(a, b)),
+                "equal values compare unequal");
+        PT_Test_assertStrEqual("0", uintStr(hugeint_equal(a, c)),
+                "different values compare equal");
+        PT_Test_assertStrEqual("1", uintStr(hugeint_hash(a, 42)
+                    == hugeint_hash(b, 42)), "equal values hash differently");
+        PT_Test_assertStrEqual("0", uintStr(hugeint_hash(a, 42)
+                    == hugeint_hash(c, 42)), "hash ignores low limb");
+        PT_Test_assertStrEqual("0", uintStr(hugeint_hash(a, 42)
+                    == hugeint_hash(a, 43)), "hash ignores seed");
+        hugeint_free(c);
+        hugeint_free(b);
+        hugeint_free(a);
+        free(decimal);
+        free(x);
+    }
+
+    hugeint *zero = hugeint_create();
+    hugeint *big = hugeint_powUint(2, 256);
+    PT_Test_assertStrEqual("0", uintStr(hugeint_equal(zero, big)),
+            "different lengths compare equal");
+    PT_Test_assertStrEqual("0", uintStr(hugeint_hash(zero, 0)
+                == hugeint_hash(big, 0)), "different lengths hash equally");
+    hugeint_free(big);
+    hugeint_free(zero);
+    PT_Test_pass();
+}
+
+PT_TESTMETHOD(longDecimalStreamsAreCorrect)
+{
+    char *x = randomHex(60000, 53);
+    hugeint *a = hugeint_parseHex(x);
+    char *expected = hugeint_toString(a);
+    struct chunkReader cr = { expected, 1000 };
+    hugeint *b = hugeint_readDecimalFrom(readChunk, &cr);
+    char *bStr = hugeint_toString(b);
+    PT_Test_assertStrEqual(expected, bStr, "wrong long decimal stream");
+    free(bStr);
+    free(expected);
+    hugeint_free(b);
+    hugeint_free(a);
+    free(x);
     PT_Test_pass();
 }